@@ -0,0 +1,114 @@
+//
+// Benchmark for long List_search() walks over the node pool.
+//
+// Usage: ./bench [walks] [scattered|linear] [doubly|forward]
+//
+// Fills the whole pool (LIST_MAX_NUM_NODES, set at compile time) with a single list and then times List_search() walks
+// that never match, so every walk visits every node.  Every node holds its own item, which the comparator reads, so a walk
+// has to load both the nodes and the items.  The list is assembled from LIST_MAX_NUM_HEADS pieces so that
+// neighbouring nodes in the list are not neighbours in memory, as happens in a pool that has been in use for a while.
+// The "linear" layout appends every item to one list instead, leaving the list in nodes[] order.  The "forward" profile
+// uses forward-only lists (List_create_forward()) instead of doubly linked ones.
+// Run it under `perf stat -e dTLB-load-misses,dTLB-loads` to see the effect of the pool backing on TLB misses.
+//
+
+#include "list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(condition) do{ \
+    if (!(condition)) { \
+        printf("ERROR: %s (@%d): failed condition \"%s\"\n", __func__, __LINE__, #condition); \
+        exit(1);\
+    }\
+} while(0)
+
+// The items, one per node.  Item i holds the value i.
+static int *items;
+
+// For searching.  Compares the values of the items, so every visited item is loaded.
+static bool valueEquals(void *pItem, void *pArg) {
+    return *(int *) pItem == *(int *) pArg;
+}
+
+static void noFree(void *pItem) {
+    (void) pItem;
+}
+
+static double elapsedNs(struct timespec *start, struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+// Builds a list holding every node of the pool.  Each item is appended to one of LIST_MAX_NUM_HEADS lists picked at random,
+// and the lists are then concatenated in random order, so consecutive nodes of the result are far apart in nodes[].
+static List *buildScatteredList(List *(*create)()) {
+    static List *lists[LIST_MAX_NUM_HEADS];
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        lists[i] = create();
+        CHECK(lists[i] != NULL);
+    }
+    unsigned int seed = 1;
+    for (int i = 0; i < LIST_MAX_NUM_NODES; ++i) {
+        seed = seed * 1103515245 + 12345;
+        CHECK(List_append(lists[(seed >> 8) % LIST_MAX_NUM_HEADS], &items[i]) == 0);
+    }
+    for (int i = LIST_MAX_NUM_HEADS - 1; i > 0; --i) {
+        seed = seed * 1103515245 + 12345;
+        int j = (seed >> 8) % (i + 1);
+        List *temp = lists[i];
+        lists[i] = lists[j];
+        lists[j] = temp;
+    }
+    CHECK(List_count(lists[0]) > 0);
+    for (int i = 1; i < LIST_MAX_NUM_HEADS; ++i) {
+        List_concat(lists[0], lists[i]);
+    }
+    CHECK(List_count(lists[0]) == LIST_MAX_NUM_NODES);
+    return lists[0];
+}
+
+// Builds a list holding every node of the pool by appending, so the list follows nodes[] order
+static List *buildLinearList(List *(*create)()) {
+    List *pList = create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < LIST_MAX_NUM_NODES; ++i) {
+        CHECK(List_append(pList, &items[i]) == 0);
+    }
+    return pList;
+}
+
+int main(int argc, char **argv) {
+    int walks = argc > 1 ? atoi(argv[1]) : 20;
+    bool linear = argc > 2 && strcmp(argv[2], "linear") == 0;
+    bool forward = argc > 3 && strcmp(argv[3], "forward") == 0;
+    List *(*create)() = forward ? List_create_forward : List_create;
+    struct timespec start, end;
+
+    items = malloc(sizeof(int) * LIST_MAX_NUM_NODES);
+    CHECK(items != NULL);
+    for (int i = 0; i < LIST_MAX_NUM_NODES; ++i) {
+        items[i] = i;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    List *pList = linear ? buildLinearList(create) : buildScatteredList(create);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("nodes: %d (%s, %s)\n", LIST_MAX_NUM_NODES, linear ? "linear" : "scattered", forward ? "forward" : "doubly");
+    printf("build: %.1f ms\n", elapsedNs(&start, &end) / 1e6);
+
+    int missing = -1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < walks; ++i) {
+        List_first(pList);
+        CHECK(List_search(pList, valueEquals, &missing) == NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = elapsedNs(&start, &end);
+    printf("search: %d walks, %.2f ns/node, %.1f Mnodes/s\n", walks, ns / ((double) walks * LIST_MAX_NUM_NODES),
+           (double) walks * LIST_MAX_NUM_NODES / ns * 1e3);
+
+    List_free(pList, noFree);
+    free(items);
+    return 0;
+}
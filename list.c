@@ -1,48 +1,221 @@
+#ifdef LIST_TRACE
+// When tracing, the List_* functions below are compiled under Untraced_ names, and the tracing versions at the end of this file wrap them.  Calls
+// between List_* functions inside this file go to the untraced versions, so only the client's calls are recorded.
+#define List_create Untraced_List_create
+#define List_create_forward Untraced_List_create_forward
+#define List_count Untraced_List_count
+#define List_first Untraced_List_first
+#define List_last Untraced_List_last
+#define List_next Untraced_List_next
+#define List_prev Untraced_List_prev
+#define List_curr Untraced_List_curr
+#define List_add Untraced_List_add
+#define List_insert Untraced_List_insert
+#define List_append Untraced_List_append
+#define List_prepend Untraced_List_prepend
+#define List_remove Untraced_List_remove
+#define List_concat Untraced_List_concat
+#define List_concat_checked Untraced_List_concat_checked
+#define List_cursor Untraced_List_cursor
+#define List_split_at_current Untraced_List_split_at_current
+#define List_splice Untraced_List_splice
+#define List_splice_n Untraced_List_splice_n
+#define List_clone_cow Untraced_List_clone_cow
+#define List_free Untraced_List_free
+#define List_trim Untraced_List_trim
+#define List_search Untraced_List_search
+#endif
+
 #include "list.h"
 #include <stdio.h>
 #include <assert.h>
+#ifdef LIST_POOL_MMAP
+#include <stdint.h>
+#include <sys/mman.h>
+#ifdef LIST_HAVE_LIBNUMA
+#include <numa.h>
+#endif
+#endif
 
 // Declaring a static array of list heads, and a static integer numHeads that counts the number of heads currently in use.
 static List heads[LIST_MAX_NUM_HEADS];
 static int numHeads = 0;
 
 // Declaring a static array of list nodes, and a static integer numNodes that counts the number of heads currently in use.
+#ifdef LIST_POOL_MMAP
+static Node *nodes = NULL; // Mapped on the first List_create()
+#else
 static Node nodes[LIST_MAX_NUM_NODES];
+#endif
 static int numNodes = 0;
 
-// Declaring a pointer to the first element in a singly linked list of available heads.
-static Node *availableNodes;
+// Declaring the separate pool of nodes for forward-only lists, with the same bookkeeping as nodes[]
+#ifdef LIST_POOL_MMAP
+static ForwardNode *forwardNodes = NULL; // Mapped on the first List_create_forward()
+#else
+static ForwardNode forwardNodes[LIST_MAX_NUM_FORWARD_NODES];
+#endif
+static int numForwardNodes = 0;
+static ForwardNode *availableForwardNodes = NULL;
+static int freshForwardNodes = 0;
+
+// Declaring a pointer to the first element in a singly linked list of available nodes.  Only nodes that have been returned by Return_node() are
+// kept on this list; nodes that have never been handed out are served from freshNodes instead.
+static Node *availableNodes = NULL;
+
+// Declaring a pointer to the first element in a singly linked list of available heads.  Like availableNodes, it only holds recycled heads.
+static List *availableHeads = NULL;
+
+// Declaring high-water indices into nodes[] and heads[].  Every element at or above these indices has never been used, so it can be handed out
+// without touching the free lists.  This avoids threading the whole pool into a free list up front on the first List_create().
+static int freshNodes = 0;
+static int freshHeads = 0;
+
+// Prefetching used by the traversals of whole lists (List_search() and List_free()).  Each keeps a lookahead pointer LIST_PREFETCH_DISTANCE
+// nodes further along the list than the node being worked on, and prefetches the item of the node it reaches.  The lookahead pointer only waits
+// for the nodes themselves, so the loads of the items can overlap with each other and with the work on the nodes in between.
+// It is off unless list.c is compiled with -DLIST_PREFETCH: the walk along the nodes stays a chain of dependent loads, and out-of-order
+// execution already overlaps the item loads with it, so bench showed no gain.
+#ifndef LIST_PREFETCH_DISTANCE
+#define LIST_PREFETCH_DISTANCE 8
+#endif
+
+#if defined(__GNUC__) && defined(LIST_PREFETCH)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#define PREFETCH_LOOKAHEAD LIST_PREFETCH_DISTANCE
+#else
+#define PREFETCH(addr) ((void) (addr))
+#define PREFETCH_LOOKAHEAD 0
+#endif
+
+// This function prefetches the item of the lookahead node ahead and returns the node after it, or NULL once the end of the list is reached.
+static inline Node *Lookahead_step(Node *ahead) {
+    if (ahead == NULL) {
+        return NULL;
+    }
+    PREFETCH(ahead->item);
+    return ahead->next;
+}
+
+// This function returns the starting lookahead pointer for a traversal beginning at pNode, prefetching the items on the way.  Returns NULL if the
+// list ends first, or if prefetching is turned off.
+static inline Node *Lookahead_start(Node *pNode) {
+    if (PREFETCH_LOOKAHEAD == 0) {
+        return NULL;
+    }
+    Node *ahead = pNode;
+    for (int i = 0; i < PREFETCH_LOOKAHEAD && ahead != NULL; ++i) {
+        ahead = Lookahead_step(ahead);
+    }
+    return ahead;
+}
+
+// Same as Lookahead_step() and Lookahead_start(), for the nodes of forward-only lists.
+static inline ForwardNode *Forward_lookahead_step(ForwardNode *ahead) {
+    if (ahead == NULL) {
+        return NULL;
+    }
+    PREFETCH(ahead->item);
+    return ahead->next;
+}
 
-// Declaring a pointer to the first element in a singly linked list of available nodes.
-static List *availableHeads;
+static inline ForwardNode *Forward_lookahead_start(ForwardNode *pNode) {
+    if (PREFETCH_LOOKAHEAD == 0) {
+        return NULL;
+    }
+    ForwardNode *ahead = pNode;
+    for (int i = 0; i < PREFETCH_LOOKAHEAD && ahead != NULL; ++i) {
+        ahead = Forward_lookahead_step(ahead);
+    }
+    return ahead;
+}
+
+#ifdef LIST_POOL_MMAP
+// Size of the huge pages the pool mapping is rounded and aligned to
+#define LIST_HUGE_PAGE_SIZE ((size_t) 2 * 1024 * 1024)
+
+// This function maps size bytes of memory to back a node pool.  It first asks for explicit huge pages, and if none are reserved it
+// maps ordinary pages aligned to a huge page boundary and asks the kernel to back them with transparent huge pages.  Returns a
+// pointer to the memory on success, NULL on failure.
+static void *Map_pool(size_t size) {
+    size = (size + LIST_HUGE_PAGE_SIZE - 1) & ~(LIST_HUGE_PAGE_SIZE - 1);
+    void *pool = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    pool = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (pool == MAP_FAILED) {
+        // Over-mapping by one huge page so that the start of the pool can be aligned, then unmapping the unused ends
+        char *raw = mmap(NULL, size + LIST_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return NULL;
+        }
+        char *aligned = (char *) (((uintptr_t) raw + LIST_HUGE_PAGE_SIZE - 1) & ~((uintptr_t) LIST_HUGE_PAGE_SIZE - 1));
+        if (aligned != raw) {
+            munmap(raw, aligned - raw);
+        }
+        munmap(aligned + size, raw + LIST_HUGE_PAGE_SIZE - aligned);
+        pool = aligned;
+#ifdef MADV_HUGEPAGE
+        madvise(pool, size, MADV_HUGEPAGE);
+#endif
+    }
+#if defined(LIST_POOL_NUMA_NODE) && defined(LIST_HAVE_LIBNUMA)
+    // Binding the pool to the requested NUMA node.  If NUMA is unavailable the pages are placed on first touch.
+    if (numa_available() != -1) {
+        numa_tonode_memory(pool, size, LIST_POOL_NUMA_NODE);
+    }
+#endif
+    return pool;
+}
+#endif
 
-// Declaring an indicator that indicates whether or not the client is performing their first List_create()
-static bool firstCreate = true;
+// This function takes pList out of the ring of lists it shares its nodes with.
+static void Leave_sharing(List *pList) {
+    List *previous = pList;
+    while (previous->sharedNext != pList) {
+        previous = previous->sharedNext;
+    }
+    previous->sharedNext = pList->sharedNext;
+    pList->sharedNext = pList;
+}
 
-// Creates two singly linked lists.  One of the available nodes, and one of the available heads.
-static void Constructor() {
-    // Creating initial singly linked list of available nodes
-    availableNodes = &nodes[numNodes];
-    Node *nodePtr = availableNodes;
-    for (int i = 1; i < LIST_MAX_NUM_NODES; ++i) {
-        nodePtr->next = &nodes[i];
-        nodePtr = nodePtr->next;
+// This function takes pList out of the ring of lists of its clone family.
+static void Leave_family(List *pList) {
+    List *previous = pList;
+    while (previous->cloneNext != pList) {
+        previous = previous->cloneNext;
     }
-    nodePtr->next = NULL;
+    previous->cloneNext = pList->cloneNext;
+    pList->cloneNext = pList;
+}
 
-    // Creating initial singly linked list of available heads
-    availableHeads = &heads[numHeads];
-    List *headPtr = availableHeads;
-    for (int j = 1; j < LIST_MAX_NUM_HEADS; ++j) {
-        headPtr->next = &heads[j];
-        headPtr = headPtr->next;
+// This function puts pList into the clone family of pOther, merging their two families if they are different.  It is called before items of pOther
+// are moved into pList, so that List_free() checks pList before freeing items that pOther's clones may still hold.  If pOther has no clone family
+// and holds each of its items once, they are held by no other list, so nothing is done.  If pList is already in the family, or pOther may repeat
+// items, the items moved into pList may repeat ones it holds.
+static void Join_family(List *pList, List *pOther) {
+    if (pOther->cloneNext == pOther && !pOther->mayRepeatItems) {
+        return;
+    }
+    if (pOther->mayRepeatItems) {
+        pList->mayRepeatItems = true;
+    }
+    for (List *member = pOther->cloneNext; member != pOther; member = member->cloneNext) {
+        if (member == pList) {
+            pList->mayRepeatItems = true;
+            return;
+        }
     }
-    headPtr->next = NULL;
+    List *next = pList->cloneNext;
+    pList->cloneNext = pOther->cloneNext;
+    pOther->cloneNext = next;
 }
 
-// This function takes a list head and initializes is values
+// This function takes a list head and initializes is values.  An empty list holds no shared nodes or items, so it also leaves its sharing ring and its clone family.
 static void initializeHead(List *pList) {
     assert(pList != NULL);
+    Leave_sharing(pList);
+    Leave_family(pList);
     pList->current = NULL;
     pList->currentOutOfBoundsBack = true; // These 2 values are set to be both true only in the case when pList has no nodes, which in this case the we say the current item is both
     // before the list head and after the list tail
@@ -50,7 +223,8 @@ static void initializeHead(List *pList) {
     pList->head = NULL;
     pList->size = 0;
     pList->tail = NULL;
-    pList->next = NULL;
+    pList->mayRepeatItems = false;
+    pList->next = NULL; // head, tail and current share their storage with forwardHead, forwardTail and forwardCurrent, so both kinds of list are cleared
 }
 
 static void initializeNode(Node *pNode, void *pItem) {
@@ -59,10 +233,20 @@ static void initializeNode(Node *pNode, void *pItem) {
     pNode->item = pItem;
 }
 
+// This function removes a node from the list of available nodes (or, if that list is empty, takes the next never used node from nodes[])
+// and returns a pointer to it.
 static void *Get_new_node(void *pItem) {
     assert(numNodes < LIST_MAX_NUM_NODES);
-    Node  * newNode = availableNodes;
-    availableNodes = availableNodes->next;
+    Node *newNode;
+    if (availableNodes != NULL) {
+        // Reusing a node that was previously returned by Return_node()
+        newNode = availableNodes;
+        availableNodes = availableNodes->next;
+    } else {
+        // No recycled nodes are available, so the next fresh node in the pool is used
+        assert(freshNodes < LIST_MAX_NUM_NODES);
+        newNode = &nodes[freshNodes++];
+    }
     numNodes++;
 
     initializeNode(newNode, pItem);
@@ -74,15 +258,31 @@ static void *Get_new_node(void *pItem) {
 static void *get_new_head(){
     assert(numHeads < LIST_MAX_NUM_HEADS); // Checking to ensure there is an available head.  I use an assert here because if the program gets here while there are no more heads,
     // something bad has gone wrong
-    List *newHead = availableHeads;
-    availableHeads = availableHeads->next;  // Removing the head from the list of available heads
+    List *newHead;
+    if (availableHeads != NULL) {
+        newHead = availableHeads;
+        availableHeads = availableHeads->next;  // Removing the head from the list of available heads
+    } else {
+        assert(freshHeads < LIST_MAX_NUM_HEADS);
+        newHead = &heads[freshHeads++]; // No recycled heads are available, so the next fresh head is used
+    }
     numHeads++; // Incrementing the counter of the number of heads in use
+    newHead->sharedNext = newHead; // A fresh head is in no ring yet, so the rings are started before initializeHead() leaves them
+    newHead->cloneNext = newHead;
     initializeHead(newHead); // Initializing the new list head by passing its pointer to the initializeHead() function
+    newHead->forwardOnly = false; // The kind of list is kept across initializeHead() calls, so it is only set here and by List_create_forward()
 
     return newHead;
 }
 
 void print(List *pList) {
+    if (pList->forwardOnly) {
+        for (ForwardNode *temp = pList->forwardHead; temp != NULL; temp = temp->next) {
+            printf("%d ", *(int*)temp->item);
+        }
+        printf("\n");
+        return;
+    }
     Node *temp = pList->head;
     while (temp != NULL) {
         printf("%d ", *(int*)temp->item);
@@ -99,6 +299,18 @@ void printNumHeads() {
     printf("Number of Available Heads: %d \n", LIST_MAX_NUM_HEADS - numHeads);
 }
 
+int getNumNodes() {
+    return numNodes;
+}
+
+int getNumHeads() {
+    return numHeads;
+}
+
+int getNumForwardNodes() {
+    return numForwardNodes;
+}
+
 // This function accepts a pointer to a Node and returns it the list of available nodes.
 static void Return_node(Node *pNode) {
     pNode->next = availableNodes;
@@ -107,6 +319,39 @@ static void Return_node(Node *pNode) {
     numNodes--;
 }
 
+// This function removes a node from the list of available forward-only nodes (or takes the next never used one from forwardNodes[])
+// and returns a pointer to it.
+static ForwardNode *Get_new_forward_node(void *pItem) {
+    assert(numForwardNodes < LIST_MAX_NUM_FORWARD_NODES);
+    ForwardNode *newNode;
+    if (availableForwardNodes != NULL) {
+        newNode = availableForwardNodes;
+        availableForwardNodes = availableForwardNodes->next;
+    } else {
+        assert(freshForwardNodes < LIST_MAX_NUM_FORWARD_NODES);
+        newNode = &forwardNodes[freshForwardNodes++];
+    }
+    numForwardNodes++;
+    newNode->next = NULL;
+    newNode->item = pItem;
+    return newNode;
+}
+
+// This function accepts a pointer to a forward-only node and returns it the list of available forward-only nodes.
+static void Return_forward_node(ForwardNode *pNode) {
+    pNode->next = availableForwardNodes;
+    availableForwardNodes = pNode;
+    numForwardNodes--;
+}
+
+// This function returns the number of nodes still available in the pool pList takes its nodes from.
+static int Available_nodes(List *pList) {
+    if (pList->forwardOnly)
+        return LIST_MAX_NUM_FORWARD_NODES - numForwardNodes;
+    else
+        return LIST_MAX_NUM_NODES - numNodes;
+}
+
 // This function accepts a pointer to a Head and returns it the list of available Heads.
 static void Return_head(List *head) {
     initializeHead(head);
@@ -116,19 +361,441 @@ static void Return_head(List *head) {
     numHeads--;
 }
 
+// This function returns the number of nodes Make_private() needs to give pList its own copy of its nodes.
+static int Private_copy_size(List *pList) {
+    return pList->sharedNext != pList ? pList->size : 0;
+}
+
+// This function moves the current item of pList to copyNext, the copy of the node after the node Make_private() left out, or beyond the end of the
+// list if there is none.  pList has already lost the left out node; if that emptied it, it is reinitialized.
+static void Set_current_after_skipped(List *pList, void *copyNext) {
+    if (pList->size == 0) {
+        initializeHead(pList);
+    } else if (copyNext == NULL) {
+        pList->current = NULL;
+        pList->currentOutOfBoundsBack = true;
+    } else if (pList->forwardOnly) {
+        pList->forwardCurrent = copyNext;
+    } else {
+        pList->current = copyNext;
+    }
+}
+
+// Forward-only version of Make_private(), called by it once it has checked that there are enough nodes for the copy.
+static void Make_private_forward(List *pList, ForwardNode *skipNode, void **cursors, int numCursors) {
+    ForwardNode *copyHead = NULL;
+    ForwardNode *copyTail = NULL;
+    ForwardNode *copyCurrent = NULL;
+    bool currentSkipped = false; // Whether the current node was left out, so the next copy becomes the current node
+    for (ForwardNode *tempNode = pList->forwardHead; tempNode != NULL; tempNode = tempNode->next) {
+        if (tempNode == skipNode) {
+            currentSkipped = tempNode == pList->forwardCurrent;
+            continue;
+        }
+        ForwardNode *copy = Get_new_forward_node(tempNode->item);
+        if (copyTail != NULL)
+            copyTail->next = copy;
+        else
+            copyHead = copy;
+        copyTail = copy;
+        if (tempNode == pList->forwardCurrent || currentSkipped) {
+            copyCurrent = copy;
+            currentSkipped = false;
+        }
+        for (int i = 0; i < numCursors; ++i) {
+            if (cursors[i] == tempNode)
+                cursors[i] = copy;
+        }
+    }
+    Leave_sharing(pList);
+    pList->forwardHead = copyHead;
+    pList->forwardTail = copyTail;
+    pList->forwardCurrent = copyCurrent;
+    if (skipNode != NULL) {
+        pList->size--;
+        Set_current_after_skipped(pList, copyCurrent);
+    }
+}
+
+// This function gives pList its own copy of its nodes if they are shared with other lists (see List_clone_cow()), so that pList can be modified
+// without the other lists seeing it.  The current node of pList, and the numCursors nodes in cursors[], are moved to the matching copies.
+// If skipNode is not NULL, that node is left out of the copy, which removes its item from pList with one node less than pList holds.  It must be the
+// current node or the last node; if it is the current node, the node after it becomes the current one, as in List_remove().
+// Returns 0 on success, or -1 if the pool does not have enough nodes for the copy, in which case pList is unchanged.
+static int Make_private(List *pList, void *skipNode, void **cursors, int numCursors) {
+    if (pList->sharedNext == pList) {
+        return 0;
+    }
+    if (Available_nodes(pList) < Private_copy_size(pList) - (skipNode != NULL)) {
+        return -1;
+    }
+    if (pList->forwardOnly) {
+        Make_private_forward(pList, skipNode, cursors, numCursors);
+        return 0;
+    }
+    Node *copyHead = NULL;
+    Node *copyTail = NULL;
+    Node *copyCurrent = NULL;
+    bool currentSkipped = false; // Whether the current node was left out, so the next copy becomes the current node
+    for (Node *tempNode = pList->head; tempNode != NULL; tempNode = tempNode->next) {
+        if (tempNode == skipNode) {
+            currentSkipped = tempNode == pList->current;
+            continue;
+        }
+        Node *copy = Get_new_node(tempNode->item);
+        copy->previous = copyTail;
+        if (copyTail != NULL)
+            copyTail->next = copy;
+        else
+            copyHead = copy;
+        copyTail = copy;
+        if (tempNode == pList->current || currentSkipped) {
+            copyCurrent = copy;
+            currentSkipped = false;
+        }
+        for (int i = 0; i < numCursors; ++i) {
+            if (cursors[i] == tempNode)
+                cursors[i] = copy;
+        }
+    }
+    Leave_sharing(pList);
+    pList->head = copyHead;
+    pList->tail = copyTail;
+    pList->current = copyCurrent;
+    if (skipNode != NULL) {
+        pList->size--;
+        Set_current_after_skipped(pList, copyCurrent);
+    }
+    return 0;
+}
+
+// This function calls Make_private() for the functions that add an item to pList.  It first checks that the pool also has the node for the new item,
+// so that an add that is going to fail does not use up nodes on the copy.
+// Returns 0 on success, or -1 if the copy and the new node do not both fit, in which case pList is unchanged.
+static int Make_private_for_add(List *pList) {
+    if (Available_nodes(pList) < Private_copy_size(pList) + 1) {
+        return -1;
+    }
+    return Make_private(pList, NULL, NULL, 0);
+}
+
+// This function returns whether pList holds pItem.  Takes O(n).
+static bool Holds_item(List *pList, void *pItem) {
+    if (pList->forwardOnly) {
+        for (ForwardNode *tempNode = pList->forwardHead; tempNode != NULL; tempNode = tempNode->next) {
+            if (tempNode->item == pItem)
+                return true;
+        }
+    } else {
+        for (Node *tempNode = pList->head; tempNode != NULL; tempNode = tempNode->next) {
+            if (tempNode->item == pItem)
+                return true;
+        }
+    }
+    return false;
+}
+
+// This function passes pItem, an item of pList that is being freed, to pItemFreeFn, unless another list of pList's clone family still holds it, or
+// pList may repeat items and its nodes not yet freed (which List_free() leaves in pList) hold it again.  Checking the family takes O(m) for the m
+// items its other lists hold.
+static void Free_item(List *pList, FREE_FN pItemFreeFn, void *pItem) {
+    if (pList->mayRepeatItems && Holds_item(pList, pItem)) {
+        return;
+    }
+    for (List *member = pList->cloneNext; member != pList; member = member->cloneNext) {
+        if (Holds_item(member, pItem)) {
+            return;
+        }
+    }
+    (*pItemFreeFn)(pItem);
+}
+
+// The functions below implement the List_* operations for forward-only lists (see List_create_forward()).  They follow the
+// doubly linked versions, except that the node before a given node has to be found by walking from the head of the list.
+
+// This function returns the node before pNode in pList, or NULL if pNode is the first node.  Takes O(n).
+static ForwardNode *Forward_predecessor(List *pList, ForwardNode *pNode) {
+    ForwardNode *previous = NULL;
+    for (ForwardNode *tempNode = pList->forwardHead; tempNode != pNode; tempNode = tempNode->next) {
+        assert(tempNode != NULL); // pNode must be in pList
+        previous = tempNode;
+    }
+    return previous;
+}
+
+// This function makes pNode the current node of pList, which is no longer out of bounds.
+static void *Forward_set_current(List *pList, ForwardNode *pNode) {
+    pList->forwardCurrent = pNode;
+    pList->currentOutOfBoundsFront = false;
+    pList->currentOutOfBoundsBack = false;
+    return pNode->item;
+}
+
+static void *Forward_next(List *pList) {
+    if (pList->size == 0) {
+        return NULL;
+    } else if (pList->currentOutOfBoundsFront) {
+        return Forward_set_current(pList, pList->forwardHead);
+    } else if (pList->currentOutOfBoundsBack || pList->forwardCurrent->next == NULL) {
+        pList->currentOutOfBoundsBack = true;
+        pList->forwardCurrent = NULL;
+        return NULL;
+    } else {
+        pList->forwardCurrent = pList->forwardCurrent->next;
+        return pList->forwardCurrent->item;
+    }
+}
+
+// Backing up is emulated by finding the node before the current one
+static void *Forward_prev(List *pList) {
+    if (pList->size == 0) {
+        return NULL;
+    } else if (pList->currentOutOfBoundsBack) {
+        return Forward_set_current(pList, pList->forwardTail);
+    } else if (pList->currentOutOfBoundsFront || pList->forwardCurrent == pList->forwardHead) {
+        pList->currentOutOfBoundsFront = true;
+        pList->forwardCurrent = NULL;
+        return NULL;
+    } else {
+        return Forward_set_current(pList, Forward_predecessor(pList, pList->forwardCurrent));
+    }
+}
+
+// This function links a new node holding pItem into pList after previous (or at the start if previous is NULL), and makes it the current node.
+// Returns 0 on success, -1 if there is no available node.
+static int Forward_link_after(List *pList, ForwardNode *previous, void *pItem) {
+    if (numForwardNodes >= LIST_MAX_NUM_FORWARD_NODES) {
+        return -1;
+    }
+    ForwardNode *newNode = Get_new_forward_node(pItem);
+    if (previous != NULL) {
+        newNode->next = previous->next;
+        previous->next = newNode;
+    } else {
+        newNode->next = pList->forwardHead;
+        pList->forwardHead = newNode;
+    }
+    if (previous == pList->forwardTail) {
+        pList->forwardTail = newNode;
+    }
+    pList->size++;
+    Forward_set_current(pList, newNode);
+    return 0;
+}
+
+static int Forward_add(List *pList, void *pItem) {
+    if (pList->currentOutOfBoundsBack)
+        return Forward_link_after(pList, pList->forwardTail, pItem);
+    else if (pList->currentOutOfBoundsFront)
+        return Forward_link_after(pList, NULL, pItem);
+    else
+        return Forward_link_after(pList, pList->forwardCurrent, pItem);
+}
+
+// Inserting before the current node is emulated by finding the node before it
+static int Forward_insert(List *pList, void *pItem) {
+    if (pList->currentOutOfBoundsBack)
+        return Forward_link_after(pList, pList->forwardTail, pItem);
+    else if (pList->currentOutOfBoundsFront)
+        return Forward_link_after(pList, NULL, pItem);
+    else
+        return Forward_link_after(pList, Forward_predecessor(pList, pList->forwardCurrent), pItem);
+}
+
+// Removing a node other than the first is emulated by finding the node before it
+static void *Forward_remove(List *pList) {
+    ForwardNode *removed = pList->forwardCurrent;
+    void *data = removed->item;
+    if (pList->size == 1) {
+        Return_forward_node(removed);
+        initializeHead(pList);
+        return data;
+    }
+    ForwardNode *previous = Forward_predecessor(pList, removed);
+    if (previous != NULL)
+        previous->next = removed->next;
+    else
+        pList->forwardHead = removed->next;
+    if (removed == pList->forwardTail) {
+        // The last node was removed, so the current item is now beyond the end of the list
+        pList->forwardTail = previous;
+        pList->forwardCurrent = NULL;
+        pList->currentOutOfBoundsBack = true;
+    } else {
+        pList->forwardCurrent = removed->next;
+    }
+    pList->size--;
+    Return_forward_node(removed);
+    return data;
+}
+
+static void Forward_concat(List *pList1, List *pList2) {
+    if (pList1->size == 0) {
+        pList1->forwardHead = pList2->forwardHead;
+        pList1->forwardTail = pList2->forwardTail;
+        pList1->size = pList2->size;
+        pList1->forwardCurrent = NULL;
+        pList1->currentOutOfBoundsFront = true;
+        pList1->currentOutOfBoundsBack = pList1->size == 0;
+    } else if (pList2->size != 0) {
+        pList1->forwardTail->next = pList2->forwardHead;
+        pList1->forwardTail = pList2->forwardTail;
+        pList1->size += pList2->size;
+    }
+    Return_head(pList2);
+}
+
+static void Forward_free(List *pList, FREE_FN pItemFreeFn) {
+    ForwardNode *tempNode = pList->forwardHead;
+    ForwardNode *ahead = Forward_lookahead_start(tempNode);
+    while (tempNode != NULL) {
+        ahead = Forward_lookahead_step(ahead);
+        pList->forwardHead = tempNode->next;
+        Free_item(pList, pItemFreeFn, tempNode->item);
+        ForwardNode *freed = tempNode;
+        tempNode = tempNode->next;
+        Return_forward_node(freed);
+    }
+    Return_head(pList);
+}
+
+// Trimming is emulated by finding the node before the last one
+static void *Forward_trim(List *pList) {
+    ForwardNode *last = pList->forwardTail;
+    void *data = last->item;
+    ForwardNode *previous = Forward_predecessor(pList, last);
+    Return_forward_node(last);
+    if (previous == NULL) {
+        initializeHead(pList);
+        return data;
+    }
+    previous->next = NULL;
+    pList->forwardTail = previous;
+    pList->size--;
+    Forward_set_current(pList, previous);
+    return data;
+}
+
+static void *Forward_search(List *pList, COMPARATOR_FN pComparator, void *pComparisonArg) {
+    ForwardNode *tempNode = pList->forwardCurrent;
+    if (pList->currentOutOfBoundsFront && !pList->currentOutOfBoundsBack) {
+        tempNode = pList->forwardHead;
+    }
+    ForwardNode *ahead = Forward_lookahead_start(tempNode);
+    while (tempNode != NULL) {
+        ahead = Forward_lookahead_step(ahead);
+        if ((*pComparator)(tempNode->item, pComparisonArg)) {
+            return Forward_set_current(pList, tempNode);
+        }
+        tempNode = tempNode->next;
+    }
+    pList->forwardCurrent = NULL;
+    pList->currentOutOfBoundsFront = pList->size == 0;
+    pList->currentOutOfBoundsBack = true;
+    return NULL;
+}
+
+// Moves every node after the current node of pList into the empty list newList
+static void Forward_split(List *pList, List *newList) {
+    ForwardNode *first;
+    if (pList->currentOutOfBoundsBack)
+        first = NULL;
+    else if (pList->currentOutOfBoundsFront)
+        first = pList->forwardHead;
+    else
+        first = pList->forwardCurrent->next;
+    if (first == NULL) {
+        return;
+    }
+    Join_family(newList, pList);
+    int count = 0;
+    for (ForwardNode *tempNode = first; tempNode != NULL; tempNode = tempNode->next) {
+        count++;
+    }
+    newList->forwardHead = first;
+    newList->forwardTail = pList->forwardTail;
+    newList->size = count;
+    Forward_set_current(newList, first);
+    if (first == pList->forwardHead) {
+        initializeHead(pList);
+    } else {
+        // The current node is the one before first, so it becomes the last node
+        pList->forwardTail = pList->forwardCurrent;
+        pList->forwardTail->next = NULL;
+        pList->size -= count;
+    }
+}
+
+// Relinks the count nodes from fromNode to toNode out of pSrc and into pDst after pDst's current item.  Finding the node before fromNode takes
+// O(n) unless fromNode is the first node of pSrc.
+static void Forward_splice_range(List *pDst, List *pSrc, ForwardNode *fromNode, ForwardNode *toNode, int count) {
+    ForwardNode *before = Forward_predecessor(pSrc, fromNode);
+    ForwardNode *after = toNode->next;
+    if (before != NULL)
+        before->next = after;
+    else
+        pSrc->forwardHead = after;
+    if (after == NULL)
+        pSrc->forwardTail = before;
+    pSrc->size -= count;
+    if (pSrc->size == 0) {
+        initializeHead(pSrc);
+    } else if (after == NULL) {
+        pSrc->forwardCurrent = NULL;
+        pSrc->currentOutOfBoundsFront = false;
+        pSrc->currentOutOfBoundsBack = true;
+    } else {
+        Forward_set_current(pSrc, after);
+    }
+
+    ForwardNode *previous;
+    if (pDst->currentOutOfBoundsBack)
+        previous = pDst->forwardTail;
+    else if (pDst->currentOutOfBoundsFront)
+        previous = NULL;
+    else
+        previous = pDst->forwardCurrent;
+    if (previous != NULL) {
+        toNode->next = previous->next;
+        previous->next = fromNode;
+    } else {
+        toNode->next = pDst->forwardHead;
+        pDst->forwardHead = fromNode;
+    }
+    if (previous == pDst->forwardTail)
+        pDst->forwardTail = toNode;
+    pDst->size += count;
+    Forward_set_current(pDst, toNode);
+}
+
 // Makes a new, empty list, and returns its reference on success.
 // Returns a NULL pointer on failure.
 List* List_create() {
     if (numHeads >= LIST_MAX_NUM_HEADS) // If their are no more heads free heads available, function returns null
         return NULL;
-    if (firstCreate) { // Testing if this is the first time a client has called List_create().  If yes it will call the Constructor() method for some extra setup
-        Constructor();
-        firstCreate = false;
-    }
+#ifdef LIST_POOL_MMAP
+    if (nodes == NULL && (nodes = Map_pool(sizeof(Node) * LIST_MAX_NUM_NODES)) == NULL) // Mapping the node pool on the first call.  If it cannot be mapped no list
+        // can hold nodes, so NULL is returned
+        return NULL;
+#endif
     List *newList = get_new_head(); // Retrieves an available head from the linked list of available heads by calling the get_new_head() function
     return newList;
 }
 
+// Makes a new, empty forward-only list, and returns its reference on success.
+// Returns a NULL pointer on failure.
+List* List_create_forward() {
+    if (numHeads >= LIST_MAX_NUM_HEADS) // If there are no more free heads available, the function returns NULL
+        return NULL;
+#ifdef LIST_POOL_MMAP
+    if (forwardNodes == NULL && (forwardNodes = Map_pool(sizeof(ForwardNode) * LIST_MAX_NUM_FORWARD_NODES)) == NULL)
+        return NULL;
+#endif
+    List *newList = get_new_head();
+    newList->forwardOnly = true;
+    return newList;
+}
+
 // Returns the number of items in pList.
 int List_count(List* pList) {
     assert(pList != NULL);
@@ -142,6 +809,8 @@ void* List_first(List* pList) {
     if (pList->size == 0) { //Testing if pList is empty
         pList->current = NULL;
         return NULL;
+    } else if (pList->forwardOnly) {
+        return Forward_set_current(pList, pList->forwardHead);
     } else {
         // Testing if the current item is set either beyond the front or back of pList, and if so we designate that it no longer is either of these cases
         if (pList->currentOutOfBoundsBack || pList->currentOutOfBoundsFront) {
@@ -160,6 +829,8 @@ void* List_last(List* pList) {
     if (pList->size == 0) { // Testing if pList is empty
         pList->current = NULL;
         return NULL;
+    } else if (pList->forwardOnly) {
+        return Forward_set_current(pList, pList->forwardTail);
     } else {
         // Testing if the current item is set either beyond the front or back of pList, and if so we designate that it no longer is either of these cases
         if (pList->currentOutOfBoundsBack || pList->currentOutOfBoundsFront) {
@@ -176,7 +847,13 @@ void* List_last(List* pList) {
 // is returned and the current item is set to be beyond end of pList.
 void* List_next(List* pList) {
     assert(pList != NULL);
-    if (pList->currentOutOfBoundsFront) {
+    if (pList->forwardOnly) {
+        return Forward_next(pList);
+    }
+    if (pList->size == 0) {
+        // Testing if pList is empty.  There is no item to advance to, and the current item stays both before the start and beyond the end.
+        return NULL;
+    } else if (pList->currentOutOfBoundsFront) {
         // Testing if the current item is before the front of pList.  If so we automatically set the current item to the front of pList, and designate that the current
         // item is no longer before the front of pList
         pList->current = pList->head;
@@ -200,7 +877,13 @@ void* List_next(List* pList) {
 // is returned and the current item is set to be before the start of pList.
 void* List_prev(List* pList) {
     assert(pList != NULL);
-    if (pList->currentOutOfBoundsBack) {
+    if (pList->forwardOnly) {
+        return Forward_prev(pList);
+    }
+    if (pList->size == 0) {
+        // Testing if pList is empty.  There is no item to back up to, and the current item stays both before the start and beyond the end.
+        return NULL;
+    } else if (pList->currentOutOfBoundsBack) {
         // Testing if the current item is beyond the end of pList.  If so we automatically set the current item to the back of pList, and designate that the current
         // item is no longer before the front of pList
         pList->current = pList->tail;
@@ -226,6 +909,8 @@ void* List_curr(List* pList) {
     if (pList->currentOutOfBoundsBack || pList->currentOutOfBoundsFront)
         // Testing if the current item is before the start or after the end of pList.
         return NULL;
+    else if (pList->forwardOnly)
+        return pList->forwardCurrent->item;
     else
         return pList->current->item;
 }
@@ -236,6 +921,14 @@ void* List_curr(List* pList) {
 // Returns 0 on success, -1 on failure.
 int List_add(List* pList, void* pItem) {
     assert(pList != NULL);
+    if (Make_private_for_add(pList) != 0) {
+        // Testing if there is no node for the item, or if pList shares its nodes with a clone and there are not enough nodes to give it its own copy as well.
+        // If so -1 is returned to designate a failure.
+        return -1;
+    }
+    if (pList->forwardOnly) {
+        return Forward_add(pList, pItem);
+    }
     if (pList->currentOutOfBoundsBack || pList->current == pList->tail) {
         // Testing if the current item is beyond the end of pList or if it is set to the tail of the list.  In either case an item is added at the end of the list.  Hence
         // List_append() is called to perform this.
@@ -269,6 +962,14 @@ int List_add(List* pList, void* pItem) {
 // Returns 0 on success, -1 on failure.
 int List_insert(List* pList, void* pItem) {
     assert(pList != NULL);
+    if (Make_private_for_add(pList) != 0) {
+        // Testing if there is no node for the item, or if pList shares its nodes with a clone and there are not enough nodes to give it its own copy as well.
+        // If so -1 is returned to designate a failure.
+        return -1;
+    }
+    if (pList->forwardOnly) {
+        return Forward_insert(pList, pItem);
+    }
     if (pList->currentOutOfBoundsBack) {
         // Testing if the current item is beyond the end of pList.  If so we can simply call List_append() to insert pItem at the end of the list.
         return List_append(pList, pItem);
@@ -298,6 +999,14 @@ int List_insert(List* pList, void* pItem) {
 // Returns 0 on success, -1 on failure.
 int List_append(List* pList, void* pItem) {
     assert(pList != NULL);
+    if (Make_private_for_add(pList) != 0) {
+        // Testing if there is no node for the item, or if pList shares its nodes with a clone and there are not enough nodes to give it its own copy as well.
+        // If so -1 is returned to designate a failure.
+        return -1;
+    }
+    if (pList->forwardOnly) {
+        return Forward_link_after(pList, pList->forwardTail, pItem);
+    }
     if (numNodes >= LIST_MAX_NUM_NODES) {
         // Testing if there is an available node
         return -1;
@@ -331,6 +1040,14 @@ int List_append(List* pList, void* pItem) {
 // Returns 0 on success, -1 on failure.
 int List_prepend(List* pList, void* pItem) {
     assert(pList != NULL);
+    if (Make_private_for_add(pList) != 0) {
+        // Testing if there is no node for the item, or if pList shares its nodes with a clone and there are not enough nodes to give it its own copy as well.
+        // If so -1 is returned to designate a failure.
+        return -1;
+    }
+    if (pList->forwardOnly) {
+        return Forward_link_after(pList, NULL, pItem);
+    }
     if (numNodes >= LIST_MAX_NUM_NODES) {
         // Testing if there is an available node
         return -1;
@@ -367,6 +1084,13 @@ void* List_remove(List* pList) {
     if (pList->currentOutOfBoundsFront || pList->currentOutOfBoundsBack) {
         // Testing if the current item is before the front of the list or beyond the end of the list.  In either case NULL is returned
         return NULL;
+    } else if (pList->sharedNext != pList) {
+        // Testing if pList shares its nodes with a clone.  If so the current node is removed by leaving it out of the private copy pList takes, which needs one node
+        // less than pList holds.  If even that many nodes are not available, pList is left unchanged and NULL is returned
+        void *data = List_curr(pList);
+        return Make_private(pList, List_cursor(pList), NULL, 0) == 0 ? data : NULL;
+    } else if (pList->forwardOnly) {
+        return Forward_remove(pList);
     } else {
         void *data = pList->current->item;
         if (pList->size == 1) {
@@ -407,15 +1131,43 @@ void* List_remove(List* pList) {
 // pList2 no longer exists after the operation; its head is available
 // for future operations.
 void List_concat(List* pList1, List* pList2) {
+    List_concat_checked(pList1, pList2);
+}
+
+// Same as List_concat().  Returns 0 on success, or -1 if a list shares its nodes with a clone and the pool cannot hold the copies, in which case
+// both lists are unchanged.
+int List_concat_checked(List* pList1, List* pList2) {
     assert(pList1 != NULL && pList2 != NULL);
-    if (pList1->size == 0) { // Testing if pList1 is empty, which then we can just copy pList2 to pList1, and adjust the current pointer to NULL (since the current pointer of
-        // pList1 is NULL)
-        pList1 = pList2;
+    if (pList1->forwardOnly != pList2->forwardOnly) {
+        // Testing if one list is forward-only and the other is not.  Their nodes cannot be linked together, so both lists are left unchanged and -1 is returned
+        return -1;
+    }
+    if (Available_nodes(pList1) < Private_copy_size(pList1) + Private_copy_size(pList2)) {
+        // Testing if either list shares its nodes with a clone and there are not enough nodes to give both their own copies.  In this case
+        // both lists are left unchanged and -1 is returned
+        return -1;
+    }
+    Make_private(pList1, NULL, NULL, 0);
+    Make_private(pList2, NULL, NULL, 0);
+    if (pList2->size > 0) {
+        // The items of pList2 may still be held by its clones, so pList1 joins its clone family before pList2's head is returned
+        Join_family(pList1, pList2);
+    }
+    if (pList1->forwardOnly) {
+        Forward_concat(pList1, pList2);
+        return 0;
+    }
+    if (pList1->size == 0) { // Testing if pList1 is empty, which then we can just move the nodes of pList2 to pList1.  The current pointer of pList1 was
+        // out of bounds, so it is left before the start of the list
+        pList1->head = pList2->head;
+        pList1->tail = pList2->tail;
+        pList1->size = pList2->size;
         pList1->current = NULL;
+        pList1->currentOutOfBoundsFront = true;
+        pList1->currentOutOfBoundsBack = pList1->size == 0;
         Return_head(pList2);
     } else if (pList2->size == 0) { // Testing if pList2 is empty, which then we dont have to do anything except return the head of pList2 to the list of available heads
         Return_head(pList2);
-        return;
     } else {
         // Concating pList1, and pList2.  At the end we return pList2 to the list of available heads using Return_head()
         pList1->tail->next = pList2->head;
@@ -424,6 +1176,208 @@ void List_concat(List* pList1, List* pList2) {
         pList1->size += pList2->size;
         Return_head(pList2);
     }
+    return 0;
+}
+
+// Returns a cursor for the current item in pList.
+// Returns NULL if current is before the start of the pList, or after the end of the pList.
+LIST_CURSOR List_cursor(List* pList) {
+    assert(pList != NULL);
+    if (pList->currentOutOfBoundsBack || pList->currentOutOfBoundsFront)
+        return NULL;
+    else if (pList->forwardOnly)
+        return pList->forwardCurrent;
+    else
+        return pList->current;
+}
+
+// Takes every item after the current item out of pList and returns them in a new list whose current item is its first item.
+// Returns a NULL pointer on failure.
+List* List_split_at_current(List* pList) {
+    assert(pList != NULL);
+    List *newList = pList->forwardOnly ? List_create_forward() : List_create();
+    if (newList == NULL) {
+        // Testing if there is an available head.  If not, pList is left unchanged and NULL is returned
+        return NULL;
+    }
+    if (Make_private(pList, NULL, NULL, 0) != 0) {
+        // Testing if pList shares its nodes with a clone and there are not enough nodes to give it its own copy
+        Return_head(newList);
+        return NULL;
+    }
+    if (pList->forwardOnly) {
+        Forward_split(pList, newList);
+        return newList;
+    }
+
+    // Finding the first node to move.  If the current item is beyond the end of pList (which includes pList being empty), nothing is moved.
+    Node *first;
+    if (pList->currentOutOfBoundsBack) {
+        first = NULL;
+    } else if (pList->currentOutOfBoundsFront) {
+        first = pList->head;
+    } else {
+        first = pList->current->next;
+    }
+    if (first == NULL) {
+        return newList;
+    }
+    Join_family(newList, pList); // The moved items may still be held by clones of pList
+
+    // Counting the moved nodes, then handing them to newList without touching the nodes themselves except for the link at the cut
+    int count = 0;
+    for (Node *tempNode = first; tempNode != NULL; tempNode = tempNode->next) {
+        count++;
+    }
+    newList->head = first;
+    newList->tail = pList->tail;
+    newList->current = first;
+    newList->size = count;
+    newList->currentOutOfBoundsFront = false;
+    newList->currentOutOfBoundsBack = false;
+
+    if (first == pList->head) {
+        // Every node was moved, so pList is reinitialized to an empty list
+        initializeHead(pList);
+    } else {
+        pList->tail = first->previous;
+        pList->tail->next = NULL;
+        pList->size -= count;
+    }
+    first->previous = NULL;
+    return newList;
+}
+
+// Relinks the count nodes from fromCursor to toCursor out of pSrc and into pDst after pDst's current item.  Used by List_splice() and List_splice_n().
+static int Splice_range(List *pDst, List *pSrc, LIST_CURSOR fromCursor, LIST_CURSOR toCursor, int count) {
+    assert(pDst != NULL && pSrc != NULL && pDst != pSrc);
+    assert(fromCursor != NULL && toCursor != NULL && count > 0 && count <= pSrc->size);
+    if (pDst->forwardOnly != pSrc->forwardOnly) {
+        // Testing if one list is forward-only and the other is not.  Their nodes cannot be linked together, so both lists are left unchanged and -1 is returned
+        return -1;
+    }
+
+    // Giving both lists their own nodes if they share them with clones, keeping the cursors pointing into pSrc's copy
+    void *range[2] = {fromCursor, toCursor};
+    if (Available_nodes(pSrc) < Private_copy_size(pSrc) + Private_copy_size(pDst)) {
+        // Testing if there are enough nodes for both copies.  If not, both lists are left unchanged and -1 is returned
+        return -1;
+    }
+    Make_private(pSrc, NULL, range, 2);
+    Make_private(pDst, NULL, NULL, 0);
+    Join_family(pDst, pSrc); // The moved items may still be held by clones of pSrc
+    if (pSrc->forwardOnly) {
+        Forward_splice_range(pDst, pSrc, range[0], range[1], count);
+        return 0;
+    }
+    Node *fromNode = range[0];
+    Node *toNode = range[1];
+
+    // Unlinking the range from pSrc.  The node after the range becomes the current node of pSrc.
+    Node *before = fromNode->previous;
+    Node *after = toNode->next;
+    if (before != NULL)
+        before->next = after;
+    else
+        pSrc->head = after;
+    if (after != NULL)
+        after->previous = before;
+    else
+        pSrc->tail = before;
+    pSrc->size -= count;
+    if (pSrc->size == 0) {
+        initializeHead(pSrc);
+    } else if (after == NULL) {
+        pSrc->current = NULL;
+        pSrc->currentOutOfBoundsFront = false;
+        pSrc->currentOutOfBoundsBack = true;
+    } else {
+        pSrc->current = after;
+        pSrc->currentOutOfBoundsFront = false;
+        pSrc->currentOutOfBoundsBack = false;
+    }
+
+    // Finding the node of pDst the range goes after, following the same rules as List_add().  NULL means the range goes at the start.
+    Node *previous;
+    if (pDst->currentOutOfBoundsBack)
+        previous = pDst->tail;
+    else if (pDst->currentOutOfBoundsFront)
+        previous = NULL;
+    else
+        previous = pDst->current;
+
+    // Linking the range into pDst and making its last node the current node
+    Node *next = previous != NULL ? previous->next : pDst->head;
+    fromNode->previous = previous;
+    toNode->next = next;
+    if (previous != NULL)
+        previous->next = fromNode;
+    else
+        pDst->head = fromNode;
+    if (next != NULL)
+        next->previous = toNode;
+    else
+        pDst->tail = toNode;
+    pDst->size += count;
+    pDst->current = toNode;
+    pDst->currentOutOfBoundsFront = false;
+    pDst->currentOutOfBoundsBack = false;
+    return 0;
+}
+
+// Moves the items of pSrc from fromCursor up to and including toCursor into pDst, directly after pDst's current item.
+int List_splice(List* pDst, List* pSrc, LIST_CURSOR fromCursor, LIST_CURSOR toCursor) {
+    assert(pSrc != NULL && fromCursor != NULL && toCursor != NULL);
+    int count = 1;
+    if (pSrc->forwardOnly) {
+        for (ForwardNode *tempNode = fromCursor; tempNode != toCursor; tempNode = tempNode->next) {
+            assert(tempNode->next != NULL); // toCursor must be reachable from fromCursor
+            count++;
+        }
+    } else {
+        for (Node *tempNode = fromCursor; tempNode != toCursor; tempNode = tempNode->next) {
+            assert(tempNode->next != NULL); // toCursor must be reachable from fromCursor
+            count++;
+        }
+    }
+    return Splice_range(pDst, pSrc, fromCursor, toCursor, count);
+}
+
+// Same as List_splice(), with the number of items in the range supplied by the caller.
+int List_splice_n(List* pDst, List* pSrc, LIST_CURSOR fromCursor, LIST_CURSOR toCursor, int count) {
+    return Splice_range(pDst, pSrc, fromCursor, toCursor, count);
+}
+
+// Makes a new list sharing pList's nodes, and returns its reference on success.  The nodes are copied by whichever list is modified first.
+// Returns a NULL pointer on failure.
+List* List_clone_cow(List* pList) {
+    assert(pList != NULL);
+    List *clone = pList->forwardOnly ? List_create_forward() : List_create();
+    if (clone == NULL) {
+        // Testing if there is an available head.  If not, NULL is returned
+        return NULL;
+    }
+    if (pList->forwardOnly) {
+        clone->forwardHead = pList->forwardHead;
+        clone->forwardTail = pList->forwardTail;
+        clone->forwardCurrent = pList->forwardCurrent;
+    } else {
+        clone->head = pList->head;
+        clone->tail = pList->tail;
+        clone->current = pList->current;
+    }
+    clone->currentOutOfBoundsFront = pList->currentOutOfBoundsFront;
+    clone->currentOutOfBoundsBack = pList->currentOutOfBoundsBack;
+    clone->size = pList->size;
+    if (pList->size > 0) {
+        // Adding clone to the ring of lists sharing pList's nodes, and to pList's clone family.  An empty list has no nodes or items to share.
+        clone->sharedNext = pList->sharedNext;
+        pList->sharedNext = clone;
+        clone->cloneNext = pList->cloneNext;
+        pList->cloneNext = clone;
+        clone->mayRepeatItems = pList->mayRepeatItems;
+    }
+    return clone;
 }
 
 // Delete pList. pItemFreeFn is a pointer to a routine that frees an item.
@@ -432,17 +1386,28 @@ void List_concat(List* pList1, List* pList2) {
 // available for future operations.
 void List_free(List* pList, FREE_FN pItemFreeFn) {
     assert(pList != NULL);
+    if (pList->sharedNext != pList) {
+        // Testing if pList shares its nodes with a clone.  If so its nodes and items still belong to the other lists, so only the head is returned.
+        Return_head(pList);
+        return;
+    }
+    if (pList->forwardOnly) {
+        Forward_free(pList, pItemFreeFn);
+        return;
+    }
     // Function accepts pList, and passes the items contained in each node to the client defined function pItemFreeFn to free the item.  Then each node is returned to the
     // list of available nodes by calling Return_node().  Finally, we return the head for pList to the list of available available by calling Return_head().
     Node *tempNode = pList->head;
     Node *tempNode2;
+    Node *ahead = Lookahead_start(tempNode);
     while (tempNode != NULL) {
-        (*pItemFreeFn)(tempNode->item);
+        ahead = Lookahead_step(ahead);
+        pList->head = tempNode->next; // Leaving the nodes not yet freed in pList, for Free_item()
+        Free_item(pList, pItemFreeFn, tempNode->item);
         tempNode2 = tempNode;
         tempNode = tempNode->next;
         Return_node(tempNode2);
     }
-    printf("\n");
 
     Return_head(pList);
 
@@ -455,6 +1420,17 @@ void* List_trim(List* pList) {
     if (pList->size == 0) {
         // Testing if the size of pList is 0.  In this case NULL is returned
         return NULL;
+    } else if (pList->sharedNext != pList) {
+        // Testing if pList shares its nodes with a clone.  If so the last node is removed by leaving it out of the private copy pList takes, as in List_remove(),
+        // and the new last item is made the current one.  If there are not enough nodes for the copy, pList is left unchanged and NULL is returned
+        void *data = pList->forwardOnly ? pList->forwardTail->item : pList->tail->item;
+        if (Make_private(pList, pList->forwardOnly ? (void *) pList->forwardTail : (void *) pList->tail, NULL, 0) != 0) {
+            return NULL;
+        }
+        List_last(pList);
+        return data;
+    } else if (pList->forwardOnly) {
+        return Forward_trim(pList);
     } else {
         Node *tempNode = pList->tail;
         pList->current = pList->tail->previous;
@@ -466,8 +1442,10 @@ void* List_trim(List* pList) {
             initializeHead(pList);
             return tempNode->item;
         }
-        // Removing the last node from the list and returning its item
+        // Removing the last node from the list and returning its item.  The new last item is the current one, so the current item is no longer out of bounds.
         pList->size--;
+        pList->currentOutOfBoundsFront = false;
+        pList->currentOutOfBoundsBack = false;
         pList->current->next = NULL;
         pList->tail = pList->current;
         Return_node(tempNode);
@@ -487,10 +1465,20 @@ void* List_trim(List* pList) {
 typedef bool (*COMPARATOR_FN)(void* pItem, void* pComparisonArg);
 void* List_search(List* pList, COMPARATOR_FN pComparator, void* pComparisonArg) {
     assert(pList != NULL);
+    if (pList->forwardOnly) {
+        return Forward_search(pList, pComparator, pComparisonArg);
+    }
     Node *tempNode = pList->current; // Set tempNode to the current node, to start search from the current node.
+    if (pList->currentOutOfBoundsFront && !pList->currentOutOfBoundsBack) {
+        // Testing if the current item is before the start of pList.  If so the search starts at the first item.
+        tempNode = pList->head;
+    }
+    Node *ahead = Lookahead_start(tempNode);
     while (tempNode != NULL) { // Continue the search until either the end of the list is reached or if the pComparisonArg is found.
+        ahead = Lookahead_step(ahead); // Starting the load of an item further along while the comparator runs on this one.
         if ((*pComparator)(tempNode->item, pComparisonArg)) {
             pList->current = tempNode;
+            pList->currentOutOfBoundsFront = false;
             return pList->current->item;
         }
         tempNode = tempNode->next;
@@ -498,6 +1486,379 @@ void* List_search(List* pList, COMPARATOR_FN pComparator, void* pComparisonArg)
 
     // If not found, current is set to be beyond the end of the list
     pList->current = NULL;
+    pList->currentOutOfBoundsFront = pList->size == 0;
     pList->currentOutOfBoundsBack = true;
     return NULL;
 }
+
+#ifdef LIST_TRACE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#undef List_create
+#undef List_create_forward
+#undef List_count
+#undef List_first
+#undef List_last
+#undef List_next
+#undef List_prev
+#undef List_curr
+#undef List_add
+#undef List_insert
+#undef List_append
+#undef List_prepend
+#undef List_remove
+#undef List_concat
+#undef List_concat_checked
+#undef List_cursor
+#undef List_split_at_current
+#undef List_splice
+#undef List_splice_n
+#undef List_clone_cow
+#undef List_free
+#undef List_trim
+#undef List_search
+
+// Number of records kept by each thread's ring buffer.  Must be a power of two.
+#ifndef LIST_TRACE_RING_SIZE
+#define LIST_TRACE_RING_SIZE 4096
+#endif
+
+// Maximum number of threads that hold a ring buffer at once.  A thread's ring buffer is handed back when the thread exits, and is then reused,
+// records included, by the next thread that needs one.  Calls from threads started while every ring buffer is held are not recorded.
+#ifndef LIST_TRACE_MAX_THREADS
+#define LIST_TRACE_MAX_THREADS 64
+#endif
+
+// Operations recorded in the trace, in the order of traceOpNames[]
+typedef enum {
+    TRACE_CREATE, TRACE_CREATE_FORWARD, TRACE_COUNT, TRACE_FIRST, TRACE_LAST, TRACE_NEXT, TRACE_PREV, TRACE_CURR, TRACE_ADD,
+    TRACE_INSERT, TRACE_APPEND, TRACE_PREPEND, TRACE_REMOVE, TRACE_CONCAT, TRACE_CONCAT_CHECKED, TRACE_CURSOR, TRACE_SPLIT_AT_CURRENT, TRACE_SPLICE,
+    TRACE_SPLICE_N, TRACE_CLONE_COW, TRACE_FREE, TRACE_TRIM, TRACE_SEARCH
+} TraceOp;
+
+static const char *traceOpNames[] = {
+    "List_create", "List_create_forward", "List_count", "List_first", "List_last", "List_next", "List_prev", "List_curr",
+    "List_add", "List_insert", "List_append", "List_prepend", "List_remove", "List_concat", "List_concat_checked", "List_cursor",
+    "List_split_at_current", "List_splice", "List_splice_n", "List_clone_cow", "List_free", "List_trim", "List_search"
+};
+
+// One recorded call.  thread numbers the calling thread in the order threads first made a traced call (ring buffers are reused, so the
+// ring a record is in does not name its thread), list is the index of the list's head in heads[], size the list's size after the call,
+// and result is the returned int, or whether the returned pointer was non-NULL (0 for List_free() and List_concat()).
+// sequence works as a seqlock, so that List_trace_dump() can read records while their thread keeps writing: it is 2 * n + 1 while the
+// record of the ring buffer's nth call is being written, and 2 * n + 2 once it is complete.  The fields are atomics so that reading them
+// during a write is defined.  They are written with release stores, so a reader that sees any new field value also sees the odd sequence
+// number stored before it, and read with acquire loads; on x86 both compile to plain stores and loads.
+typedef struct {
+    _Atomic uint64_t sequence;
+    _Atomic uint64_t start;
+    _Atomic uint32_t duration;
+    _Atomic int32_t size;
+    _Atomic int32_t list;
+    _Atomic int32_t result;
+    _Atomic int32_t thread;
+    _Atomic uint8_t op;
+} TraceRecord;
+
+// A thread's ring buffer.  Only the thread holding it writes records, so recording needs no locks.  count is the number of records ever
+// written to it.
+typedef struct {
+    TraceRecord records[LIST_TRACE_RING_SIZE];
+    _Atomic uint64_t count;
+    atomic_bool held; // Whether a running thread holds the ring buffer
+} TraceRing;
+
+static TraceRing traceRings[LIST_TRACE_MAX_THREADS];
+
+// Ring buffer written by the threads that could not get one of traceRings[].  It is never dumped.
+static TraceRing traceDiscardRing;
+
+// The calling thread's ring buffer, or NULL before its first traced call
+static _Thread_local TraceRing *traceRing = NULL;
+
+// Number of the calling thread in the trace, given with its ring buffer, and the number the next thread gets
+static _Thread_local int32_t traceThread;
+static atomic_int traceNextThread;
+
+// Key whose destructor hands a thread's ring buffer back when the thread exits
+static pthread_key_t traceRingKey;
+static pthread_once_t traceRingKeyOnce = PTHREAD_ONCE_INIT;
+
+// This function returns the current time in ticks: TSC cycles on x86, nanoseconds elsewhere.
+static inline uint64_t Trace_now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+// Destructor of traceRingKey, handing the exiting thread's ring buffer back for reuse.
+static void Trace_release_ring(void *ring) {
+    atomic_store_explicit(&((TraceRing *) ring)->held, false, memory_order_release);
+}
+
+static void Trace_create_key() {
+    pthread_key_create(&traceRingKey, Trace_release_ring);
+}
+
+// This function gives the calling thread a ring buffer on its first traced call: a free one of traceRings[], or traceDiscardRing if all
+// are held.  It is kept out of line so that the recording path stays small.
+static __attribute__((noinline)) TraceRing *Trace_claim_ring() {
+    pthread_once(&traceRingKeyOnce, Trace_create_key);
+    traceThread = atomic_fetch_add_explicit(&traceNextThread, 1, memory_order_relaxed);
+    traceRing = &traceDiscardRing;
+    for (int i = 0; i < LIST_TRACE_MAX_THREADS; ++i) {
+        bool expected = false;
+        if (!atomic_load_explicit(&traceRings[i].held, memory_order_relaxed)
+            && atomic_compare_exchange_strong_explicit(&traceRings[i].held, &expected, true, memory_order_acquire, memory_order_relaxed)) {
+            traceRing = &traceRings[i];
+            pthread_setspecific(traceRingKey, traceRing);
+            break;
+        }
+    }
+    return traceRing;
+}
+
+// This function records a call that started at start into the calling thread's ring buffer.
+static inline void Trace_record(TraceOp op, List *pList, uint64_t start, int result) {
+    uint64_t end = Trace_now();
+    TraceRing *ring = traceRing;
+    if (__builtin_expect(ring == NULL, 0)) {
+        ring = Trace_claim_ring();
+    }
+    uint64_t position = atomic_load_explicit(&ring->count, memory_order_relaxed);
+    TraceRecord *record = &ring->records[position & (LIST_TRACE_RING_SIZE - 1)];
+    atomic_store_explicit(&record->sequence, 2 * position + 1, memory_order_relaxed);
+    atomic_store_explicit(&record->start, start, memory_order_release);
+    atomic_store_explicit(&record->duration, (uint32_t) (end - start), memory_order_release);
+    atomic_store_explicit(&record->size, pList != NULL ? pList->size : 0, memory_order_release);
+    atomic_store_explicit(&record->list, pList != NULL ? (int32_t) (pList - heads) : -1, memory_order_release);
+    atomic_store_explicit(&record->op, op, memory_order_release);
+    atomic_store_explicit(&record->result, result, memory_order_release);
+    atomic_store_explicit(&record->thread, traceThread, memory_order_release);
+    atomic_store_explicit(&record->sequence, 2 * position + 2, memory_order_release);
+    atomic_store_explicit(&ring->count, position + 1, memory_order_release);
+}
+
+// This function measures how many ticks Trace_now() advances per nanosecond.
+static double Trace_ticks_per_ns() {
+#if defined(__x86_64__) || defined(__i386__)
+    struct timespec begin, end, pause = {0, 10000000};
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    uint64_t startTicks = __rdtsc();
+    nanosleep(&pause, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t endTicks = __rdtsc();
+    double ns = (end.tv_sec - begin.tv_sec) * 1e9 + (end.tv_nsec - begin.tv_nsec);
+    return (endTicks - startTicks) / ns;
+#else
+    return 1.0;
+#endif
+}
+
+int List_trace_dump(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return -1;
+    }
+    fprintf(file, "# list-trace 1 ticks_per_ns %.6f\n", Trace_ticks_per_ns());
+    fprintf(file, "# thread op list size start duration result\n");
+    for (TraceRing *ring = traceRings; ring < traceRings + LIST_TRACE_MAX_THREADS; ++ring) {
+        uint64_t count = atomic_load_explicit(&ring->count, memory_order_acquire);
+        uint64_t first = count > LIST_TRACE_RING_SIZE ? count - LIST_TRACE_RING_SIZE : 0;
+        for (uint64_t i = first; i < count; ++i) {
+            // Reading the record between two reads of its sequence number, and skipping it if it was being written or has been overwritten
+            // by a later call in the meantime
+            TraceRecord *record = &ring->records[i & (LIST_TRACE_RING_SIZE - 1)];
+            uint64_t sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+            uint64_t start = atomic_load_explicit(&record->start, memory_order_acquire);
+            uint32_t duration = atomic_load_explicit(&record->duration, memory_order_acquire);
+            int32_t size = atomic_load_explicit(&record->size, memory_order_acquire);
+            int32_t list = atomic_load_explicit(&record->list, memory_order_acquire);
+            uint8_t op = atomic_load_explicit(&record->op, memory_order_acquire);
+            int32_t result = atomic_load_explicit(&record->result, memory_order_acquire);
+            int32_t thread = atomic_load_explicit(&record->thread, memory_order_acquire);
+            if (sequence != 2 * i + 2 || atomic_load_explicit(&record->sequence, memory_order_relaxed) != sequence) {
+                continue;
+            }
+            fprintf(file, "%d %s %d %d %llu %u %d\n", thread, traceOpNames[op], list, size, (unsigned long long) start, duration, result);
+        }
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+// The tracing versions of the List_* functions.  Each calls the untraced version and records the call.
+
+List* List_create() {
+    uint64_t start = Trace_now();
+    List *result = Untraced_List_create();
+    Trace_record(TRACE_CREATE, result, start, result != NULL);
+    return result;
+}
+
+List* List_create_forward() {
+    uint64_t start = Trace_now();
+    List *result = Untraced_List_create_forward();
+    Trace_record(TRACE_CREATE_FORWARD, result, start, result != NULL);
+    return result;
+}
+
+int List_count(List* pList) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_count(pList);
+    Trace_record(TRACE_COUNT, pList, start, result);
+    return result;
+}
+
+void* List_first(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_first(pList);
+    Trace_record(TRACE_FIRST, pList, start, result != NULL);
+    return result;
+}
+
+void* List_last(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_last(pList);
+    Trace_record(TRACE_LAST, pList, start, result != NULL);
+    return result;
+}
+
+void* List_next(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_next(pList);
+    Trace_record(TRACE_NEXT, pList, start, result != NULL);
+    return result;
+}
+
+void* List_prev(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_prev(pList);
+    Trace_record(TRACE_PREV, pList, start, result != NULL);
+    return result;
+}
+
+void* List_curr(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_curr(pList);
+    Trace_record(TRACE_CURR, pList, start, result != NULL);
+    return result;
+}
+
+int List_add(List* pList, void* pItem) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_add(pList, pItem);
+    Trace_record(TRACE_ADD, pList, start, result);
+    return result;
+}
+
+int List_insert(List* pList, void* pItem) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_insert(pList, pItem);
+    Trace_record(TRACE_INSERT, pList, start, result);
+    return result;
+}
+
+int List_append(List* pList, void* pItem) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_append(pList, pItem);
+    Trace_record(TRACE_APPEND, pList, start, result);
+    return result;
+}
+
+int List_prepend(List* pList, void* pItem) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_prepend(pList, pItem);
+    Trace_record(TRACE_PREPEND, pList, start, result);
+    return result;
+}
+
+void* List_remove(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_remove(pList);
+    Trace_record(TRACE_REMOVE, pList, start, result != NULL);
+    return result;
+}
+
+void List_concat(List* pList1, List* pList2) {
+    uint64_t start = Trace_now();
+    Untraced_List_concat(pList1, pList2);
+    Trace_record(TRACE_CONCAT, pList1, start, 0);
+}
+
+int List_concat_checked(List* pList1, List* pList2) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_concat_checked(pList1, pList2);
+    Trace_record(TRACE_CONCAT_CHECKED, pList1, start, result);
+    return result;
+}
+
+LIST_CURSOR List_cursor(List* pList) {
+    uint64_t start = Trace_now();
+    LIST_CURSOR result = Untraced_List_cursor(pList);
+    Trace_record(TRACE_CURSOR, pList, start, result != NULL);
+    return result;
+}
+
+List* List_split_at_current(List* pList) {
+    uint64_t start = Trace_now();
+    List *result = Untraced_List_split_at_current(pList);
+    Trace_record(TRACE_SPLIT_AT_CURRENT, pList, start, result != NULL);
+    return result;
+}
+
+int List_splice(List* pDst, List* pSrc, LIST_CURSOR fromCursor, LIST_CURSOR toCursor) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_splice(pDst, pSrc, fromCursor, toCursor);
+    Trace_record(TRACE_SPLICE, pDst, start, result);
+    return result;
+}
+
+int List_splice_n(List* pDst, List* pSrc, LIST_CURSOR fromCursor, LIST_CURSOR toCursor, int count) {
+    uint64_t start = Trace_now();
+    int result = Untraced_List_splice_n(pDst, pSrc, fromCursor, toCursor, count);
+    Trace_record(TRACE_SPLICE_N, pDst, start, result);
+    return result;
+}
+
+List* List_clone_cow(List* pList) {
+    uint64_t start = Trace_now();
+    List *result = Untraced_List_clone_cow(pList);
+    Trace_record(TRACE_CLONE_COW, pList, start, result != NULL);
+    return result;
+}
+
+void List_free(List* pList, FREE_FN pItemFreeFn) {
+    uint64_t start = Trace_now();
+    Untraced_List_free(pList, pItemFreeFn);
+    Trace_record(TRACE_FREE, pList, start, 0);
+}
+
+void* List_trim(List* pList) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_trim(pList);
+    Trace_record(TRACE_TRIM, pList, start, result != NULL);
+    return result;
+}
+
+void* List_search(List* pList, COMPARATOR_FN pComparator, void* pComparisonArg) {
+    uint64_t start = Trace_now();
+    void *result = Untraced_List_search(pList, pComparator, pComparisonArg);
+    Trace_record(TRACE_SEARCH, pList, start, result != NULL);
+    return result;
+}
+#else
+int List_trace_dump(const char *path) {
+    (void) path;
+    return -1;
+}
+#endif
@@ -0,0 +1,784 @@
+//
+// Randomized differential stress test for list.c.
+//
+// Usage: ./stress [-n operations] [-s seed] [-t threads] [-d trace file]
+//
+// Runs a deterministic (for a given seed) random mix of List_* operations, applying each one to both the real lists and a
+// simple array-based model, and checks after every operation that the two agree on the result, the list size and the
+// current item.  Every few operations a list is walked in both directions and compared in full, and the pool counters
+// (getNumNodes(), getNumForwardNodes(), getNumHeads()) are checked against the model.  Doubly linked and forward-only lists
+// are mixed.  The pool sizes are the ones list.c is compiled with, so build with -DLIST_MAX_NUM_NODES=...
+// -DLIST_MAX_NUM_FORWARD_NODES=... -DLIST_MAX_NUM_HEADS=... to cover other configurations.  At the end the number of
+// operations per second is reported for each operation type.
+//
+// With -t, several threads run at once, each with its own lists, its own model and its own share of the pool.  list.c has
+// no internal locking, so each operation is run under a mutex unless the harness is built with -DSTRESS_LIBRARY_IS_THREAD_SAFE.
+// With the mutex, no two List_* calls ever run at once, so ThreadSanitizer cannot find races in the list operations themselves.
+//
+// With -d, one more thread calls List_trace_dump() on the given file over and over while the others run, without taking the
+// mutex.  The trace ring buffers (list.c built with -DLIST_TRACE) are the part of list.c written for concurrent use, and this
+// runs their writers and their reader at the same time.  make stress-tsan builds the harness with tracing under ThreadSanitizer.
+//
+
+#include "list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define CHECK(condition) do{ \
+    if (!(condition)) { \
+        printf("ERROR: %s (@%d): failed condition \"%s\" (seed %llu, thread %d, operation %ld)\n", __func__, __LINE__, #condition, \
+               (unsigned long long) seed, pState->thread, pState->step); \
+        exit(1);\
+    }\
+} while(0)
+
+// Maximum number of threads in multi-threaded mode
+#define STRESS_MAX_THREADS 64
+
+// Number of distinct values of the items stored in the lists.  Values repeat, so List_search() has to find the first match after the current item.
+#define STRESS_NUM_VALUES 32
+
+// A list is compared in full against the model once every this many operations
+#define STRESS_VALIDATE_EVERY 64
+
+// Model positions of the current item that are not an index into the items
+#define BEFORE_START (-1)
+
+// Serializes the threads' use of list.c, which has no locking of its own.  Each operation (with its checks) runs under the lock.
+#ifdef STRESS_LIBRARY_IS_THREAD_SAFE
+#define lockLibrary() ((void) 0)
+#define unlockLibrary() ((void) 0)
+#else
+static pthread_mutex_t libraryLock = PTHREAD_MUTEX_INITIALIZER;
+#define lockLibrary() pthread_mutex_lock(&libraryLock)
+#define unlockLibrary() pthread_mutex_unlock(&libraryLock)
+#endif
+
+typedef enum {
+    OP_CREATE, OP_CREATE_FORWARD, OP_FREE, OP_CLONE, OP_COUNT, OP_FIRST, OP_LAST, OP_NEXT, OP_PREV, OP_CURR, OP_ADD, OP_INSERT, OP_APPEND,
+    OP_PREPEND, OP_REMOVE, OP_TRIM, OP_CONCAT, OP_SEARCH, OP_SPLIT, OP_SPLICE, NUM_OPS
+} Operation;
+
+static const char *opNames[NUM_OPS] = {
+    "List_create", "List_create_forward", "List_free", "List_clone_cow", "List_count", "List_first", "List_last", "List_next", "List_prev",
+    "List_curr", "List_add", "List_insert", "List_append", "List_prepend", "List_remove", "List_trim", "List_concat",
+    "List_search", "List_split_at_current", "List_splice"
+};
+
+// Relative frequency of each operation.  Operations adding items slightly outweigh those removing them, so the pool
+// regularly runs out and the failure paths are exercised as well.
+static const int opWeights[NUM_OPS] = {3, 3, 2, 2, 2, 5, 5, 12, 12, 4, 8, 8, 8, 8, 14, 8, 2, 4, 2, 3};
+
+// An item stored in the lists.  Every added item is a new one, so an item is only held by several lists through List_clone_cow().
+// value is what List_search() matches, freed counts the calls of the free function on the item, and mark is used by checkFree().
+typedef struct {
+    int value;
+    int freed;
+    long mark;
+} StressItem;
+
+// A list as the model sees it: its items, and the position of its current item (BEFORE_START, an index into items, or size for beyond
+// the end).  Lists with the same group share their nodes in list.c.
+typedef struct {
+    List *pList; // NULL when the slot is unused
+    StressItem **items;
+    int size;
+    int current;
+    int group;
+    bool forward; // Made by List_create_forward()
+} ModelList;
+
+typedef struct {
+    long count;
+    double ns;
+} OpStats;
+
+typedef struct {
+    int thread;
+    long step;
+    unsigned long long rng;
+    int maxHeads;   // Share of the pool this thread may use
+    int maxNodes;
+    int maxForwardNodes;
+    bool exerciseFailures; // Whether operations the model expects to run out of heads or nodes are issued
+    ModelList *lists;
+    StressItem *items; // Every item the thread has added, one per operation at most
+    long numItems;
+    long nextMark;
+    int nextGroup; // Next unused group number
+    OpStats stats[NUM_OPS];
+} ThreadState;
+
+static unsigned long long seed = 1;
+static long numOperations = 1000000;
+static double timerOverheadNs = 0;
+static const char *dumpPath = NULL; // Trace file written by the -d thread, or NULL
+static atomic_bool running; // Whether the operation threads are still running
+
+// Counts the items passed to freeCountFn by the current thread
+static _Thread_local int freeCount = 0;
+
+static void freeCountFn(void *pItem) {
+    ((StressItem *) pItem)->freed++;
+    freeCount++;
+}
+
+static bool valueEquals(void *pItem, void *pArg) {
+    return ((StressItem *) pItem)->value == *(int *) pArg;
+}
+
+static double nowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// xorshift64*, so a run is reproducible from its seed
+static int randomInt(ThreadState *pState, int bound) {
+    pState->rng ^= pState->rng >> 12;
+    pState->rng ^= pState->rng << 25;
+    pState->rng ^= pState->rng >> 27;
+    return (int) (((pState->rng * 2685821657736338717ULL) >> 33) % (unsigned long long) bound);
+}
+
+static void *itemAt(ModelList *pModel, int index) {
+    return pModel->items[index];
+}
+
+static void *modelCurrentItem(ModelList *pModel) {
+    if (pModel->current < 0 || pModel->current >= pModel->size)
+        return NULL;
+    return itemAt(pModel, pModel->current);
+}
+
+static int liveLists(ThreadState *pState) {
+    int count = 0;
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        if (pState->lists[i].pList != NULL)
+            count++;
+    }
+    return count;
+}
+
+// Number of nodes from the doubly linked or the forward-only pool the thread's lists use: lists in the same group share one set of nodes
+static int modelNodesInUse(ThreadState *pState, bool forward) {
+    int count = 0;
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        ModelList *pModel = &pState->lists[i];
+        bool firstOfGroup = pModel->pList != NULL && pModel->forward == forward;
+        for (int j = 0; j < i && firstOfGroup; ++j) {
+            if (pState->lists[j].pList != NULL && pState->lists[j].group == pModel->group)
+                firstOfGroup = false;
+        }
+        if (firstOfGroup)
+            count += pModel->size;
+    }
+    return count;
+}
+
+static bool isShared(ThreadState *pState, ModelList *pModel) {
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        ModelList *pOther = &pState->lists[i];
+        if (pOther != pModel && pOther->pList != NULL && pOther->group == pModel->group)
+            return true;
+    }
+    return false;
+}
+
+static int copySize(ThreadState *pState, ModelList *pModel) {
+    return isShared(pState, pModel) ? pModel->size : 0;
+}
+
+static int freeNodes(ThreadState *pState, bool forward) {
+    return (forward ? pState->maxForwardNodes : pState->maxNodes) - modelNodesInUse(pState, forward);
+}
+
+// Gives pModel its own group, as Make_private() does in list.c
+static void makePrivate(ThreadState *pState, ModelList *pModel) {
+    pModel->group = pState->nextGroup++;
+}
+
+// Gives pModel its own group if it has become empty, since an empty list shares no nodes
+static void leaveIfEmpty(ThreadState *pState, ModelList *pModel) {
+    if (pModel->size == 0) {
+        makePrivate(pState, pModel);
+    }
+}
+
+static void insertItems(ModelList *pModel, int index, StressItem *const *items, int count) {
+    memmove(&pModel->items[index + count], &pModel->items[index], (pModel->size - index) * sizeof(StressItem *));
+    memcpy(&pModel->items[index], items, count * sizeof(StressItem *));
+    pModel->size += count;
+}
+
+static void removeItems(ModelList *pModel, int index, int count) {
+    memmove(&pModel->items[index], &pModel->items[index + count], (pModel->size - index - count) * sizeof(StressItem *));
+    pModel->size -= count;
+}
+
+static ModelList *randomList(ThreadState *pState) {
+    int live = liveLists(pState);
+    if (live == 0)
+        return NULL;
+    int pick = randomInt(pState, live);
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        if (pState->lists[i].pList != NULL && pick-- == 0)
+            return &pState->lists[i];
+    }
+    return NULL;
+}
+
+static ModelList *freeSlot(ThreadState *pState) {
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        if (pState->lists[i].pList == NULL)
+            return &pState->lists[i];
+    }
+    return NULL;
+}
+
+static bool canCreate(ThreadState *pState) {
+    return liveLists(pState) < pState->maxHeads;
+}
+
+// Moves the current item of the real list to the model's current position, using only List_first/List_last/List_next/List_prev
+static void seekCurrent(ThreadState *pState, ModelList *pModel) {
+    if (pModel->size == 0)
+        return;
+    if (pModel->current == BEFORE_START) {
+        List_first(pModel->pList);
+        List_prev(pModel->pList);
+    } else if (pModel->current == pModel->size) {
+        List_last(pModel->pList);
+        List_next(pModel->pList);
+    } else {
+        List_first(pModel->pList);
+        for (int i = 0; i < pModel->current; ++i) {
+            List_next(pModel->pList);
+        }
+    }
+    void *current = List_curr(pModel->pList);
+    CHECK(current == modelCurrentItem(pModel));
+}
+
+// Walks the whole list forwards and backwards comparing it with the model, then restores the current item
+static void validateList(ThreadState *pState, ModelList *pModel) {
+    void *item = List_first(pModel->pList);
+    for (int i = 0; i < pModel->size; ++i) {
+        CHECK(item == itemAt(pModel, i));
+        item = List_next(pModel->pList);
+    }
+    CHECK(item == NULL);
+    item = List_last(pModel->pList);
+    for (int i = pModel->size - 1; i >= 0; --i) {
+        CHECK(item == itemAt(pModel, i));
+        item = List_prev(pModel->pList);
+    }
+    CHECK(item == NULL);
+    seekCurrent(pState, pModel);
+}
+
+// Checks the cheap invariants of a list after an operation: its size and current item
+static void checkList(ThreadState *pState, ModelList *pModel) {
+    int count = List_count(pModel->pList);
+    CHECK(count == pModel->size);
+    void *current = List_curr(pModel->pList);
+    CHECK(current == modelCurrentItem(pModel));
+}
+
+static void checkPool(ThreadState *pState) {
+    CHECK(getNumHeads() == liveLists(pState));
+    CHECK(getNumNodes() == modelNodesInUse(pState, false));
+    CHECK(getNumForwardNodes() == modelNodesInUse(pState, true));
+}
+
+// Frees the list of pModel with freeCountFn, and checks that the items passed to it were exactly those of the list that no other list holds,
+// each once.  The time spent in List_free() is added to *pNs.
+static void checkFree(ThreadState *pState, ModelList *pModel, double *pNs) {
+    // Marking the items held by the other lists
+    long mark = ++pState->nextMark;
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        ModelList *pOther = &pState->lists[i];
+        if (pOther == pModel || pOther->pList == NULL)
+            continue;
+        for (int j = 0; j < pOther->size; ++j) {
+            pOther->items[j]->mark = mark;
+        }
+    }
+    // Marking the items to be freed with a second mark.  A list that took items from its own clones may hold an item more than once.
+    long freedMark = ++pState->nextMark;
+    int expected = 0;
+    for (int i = 0; i < pModel->size; ++i) {
+        CHECK(pModel->items[i]->freed == 0);
+        if (pModel->items[i]->mark != mark && pModel->items[i]->mark != freedMark) {
+            pModel->items[i]->mark = freedMark;
+            expected++;
+        }
+    }
+    freeCount = 0;
+    double start = nowNs();
+    List_free(pModel->pList, freeCountFn);
+    *pNs += nowNs() - start;
+    CHECK(freeCount == expected);
+    for (int i = 0; i < pModel->size; ++i) {
+        CHECK(pModel->items[i]->freed == (pModel->items[i]->mark == freedMark));
+    }
+    pModel->pList = NULL;
+}
+
+// Issues one random operation against both the real lists and the model.  Returns the operation issued, or NUM_OPS if it
+// was skipped.  The time spent in the List_* call is added to *pNs.
+static Operation runOperation(ThreadState *pState, double *pNs) {
+    int totalWeight = 0;
+    for (int i = 0; i < NUM_OPS; ++i) {
+        totalWeight += opWeights[i];
+    }
+    int pick = randomInt(pState, totalWeight);
+    Operation op = 0;
+    for (int total = opWeights[0]; total <= pick && op < NUM_OPS - 1; total += opWeights[++op]);
+    ModelList *pModel = randomList(pState);
+    if (pModel == NULL)
+        op = OP_CREATE;
+    int value = randomInt(pState, STRESS_NUM_VALUES);
+    double start;
+
+    switch (op) {
+        case OP_CREATE:
+        case OP_CREATE_FORWARD: {
+            bool expected = canCreate(pState);
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            start = nowNs();
+            List *pList = op == OP_CREATE ? List_create() : List_create_forward();
+            *pNs += nowNs() - start;
+            CHECK((pList != NULL) == expected);
+            if (pList != NULL) {
+                ModelList *pSlot = freeSlot(pState);
+                pSlot->pList = pList;
+                pSlot->size = 0;
+                pSlot->current = BEFORE_START;
+                pSlot->forward = op == OP_CREATE_FORWARD;
+                leaveIfEmpty(pState, pSlot);
+                checkList(pState, pSlot);
+            }
+            return op;
+        }
+        case OP_FREE: {
+            checkFree(pState, pModel, pNs);
+            return op;
+        }
+        case OP_CLONE: {
+            bool expected = canCreate(pState);
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            start = nowNs();
+            List *pClone = List_clone_cow(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK((pClone != NULL) == expected);
+            if (pClone != NULL) {
+                ModelList *pSlot = freeSlot(pState);
+                StressItem **items = pSlot->items;
+                *pSlot = *pModel;
+                pSlot->items = items;
+                memcpy(pSlot->items, pModel->items, pModel->size * sizeof(StressItem *));
+                pSlot->pList = pClone;
+                leaveIfEmpty(pState, pSlot);
+                checkList(pState, pSlot);
+            }
+            return op;
+        }
+        case OP_COUNT: {
+            start = nowNs();
+            int count = List_count(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK(count == pModel->size);
+            return op;
+        }
+        case OP_FIRST:
+        case OP_LAST: {
+            start = nowNs();
+            void *result = op == OP_FIRST ? List_first(pModel->pList) : List_last(pModel->pList);
+            *pNs += nowNs() - start;
+            if (pModel->size > 0)
+                pModel->current = op == OP_FIRST ? 0 : pModel->size - 1;
+            CHECK(result == modelCurrentItem(pModel));
+            break;
+        }
+        case OP_NEXT: {
+            start = nowNs();
+            void *result = List_next(pModel->pList);
+            *pNs += nowNs() - start;
+            if (pModel->size > 0 && pModel->current < pModel->size)
+                pModel->current++;
+            CHECK(result == modelCurrentItem(pModel));
+            break;
+        }
+        case OP_PREV: {
+            start = nowNs();
+            void *result = List_prev(pModel->pList);
+            *pNs += nowNs() - start;
+            if (pModel->size > 0 && pModel->current > BEFORE_START)
+                pModel->current--;
+            CHECK(result == modelCurrentItem(pModel));
+            break;
+        }
+        case OP_CURR: {
+            start = nowNs();
+            void *result = List_curr(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK(result == modelCurrentItem(pModel));
+            break;
+        }
+        case OP_ADD:
+        case OP_INSERT:
+        case OP_APPEND:
+        case OP_PREPEND: {
+            // A list sharing its nodes first needs a private copy, then one more node for the new item.  Nothing is copied unless both fit.
+            int needed = copySize(pState, pModel);
+            bool expected = freeNodes(pState, pModel->forward) >= needed + 1;
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            StressItem *pItem = &pState->items[pState->numItems];
+            pItem->value = value;
+            start = nowNs();
+            int result;
+            switch (op) {
+                case OP_ADD: result = List_add(pModel->pList, pItem); break;
+                case OP_INSERT: result = List_insert(pModel->pList, pItem); break;
+                case OP_APPEND: result = List_append(pModel->pList, pItem); break;
+                default: result = List_prepend(pModel->pList, pItem); break;
+            }
+            *pNs += nowNs() - start;
+            CHECK(result == (expected ? 0 : -1));
+            if (!expected)
+                break;
+            pState->numItems++;
+            makePrivate(pState, pModel);
+
+            // Working out where the item goes from the current position, following list.h
+            int index;
+            if (op == OP_APPEND)
+                index = pModel->size;
+            else if (op == OP_PREPEND)
+                index = 0;
+            else if (pModel->size == 0 || pModel->current == pModel->size)
+                index = pModel->size;
+            else if (pModel->current == BEFORE_START)
+                index = 0;
+            else if (op == OP_ADD)
+                index = pModel->current + 1;
+            else
+                index = pModel->current;
+            insertItems(pModel, index, &pItem, 1);
+            pModel->current = index;
+            break;
+        }
+        case OP_REMOVE: {
+            // A list sharing its nodes takes a private copy without the removed item
+            bool inBounds = pModel->current >= 0 && pModel->current < pModel->size;
+            bool expected = inBounds && freeNodes(pState, pModel->forward) >= copySize(pState, pModel) - 1;
+            if (inBounds && !expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            void *removed = modelCurrentItem(pModel);
+            start = nowNs();
+            void *result = List_remove(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK(result == (expected ? removed : NULL));
+            if (!expected)
+                break;
+            makePrivate(pState, pModel);
+            removeItems(pModel, pModel->current, 1);
+            leaveIfEmpty(pState, pModel);
+            break;
+        }
+        case OP_TRIM: {
+            bool expected = pModel->size > 0 && freeNodes(pState, pModel->forward) >= copySize(pState, pModel) - 1;
+            if (pModel->size > 0 && !expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            void *removed = pModel->size > 0 ? itemAt(pModel, pModel->size - 1) : NULL;
+            start = nowNs();
+            void *result = List_trim(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK(result == (expected ? removed : NULL));
+            if (!expected)
+                break;
+            makePrivate(pState, pModel);
+            removeItems(pModel, pModel->size - 1, 1);
+            pModel->current = pModel->size > 0 ? pModel->size - 1 : BEFORE_START;
+            leaveIfEmpty(pState, pModel);
+            break;
+        }
+        case OP_CONCAT: {
+            ModelList *pOther = randomList(pState);
+            if (pOther == pModel)
+                return NUM_OPS;
+            // A forward-only list and a doubly linked list are never joined
+            bool expected = pOther->forward == pModel->forward &&
+                            freeNodes(pState, pModel->forward) >= copySize(pState, pModel) + copySize(pState, pOther);
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            start = nowNs();
+            int result = List_concat_checked(pModel->pList, pOther->pList);
+            *pNs += nowNs() - start;
+            CHECK(result == (expected ? 0 : -1));
+            if (expected) {
+                makePrivate(pState, pModel);
+                bool beyondEnd = pModel->size > 0 && pModel->current == pModel->size;
+                if (pModel->size == 0)
+                    pModel->current = BEFORE_START;
+                insertItems(pModel, pModel->size, pOther->items, pOther->size);
+                if (beyondEnd)
+                    pModel->current = pModel->size;
+                pOther->pList = NULL;
+            } else {
+                checkList(pState, pOther);
+            }
+            break;
+        }
+        case OP_SEARCH: {
+            start = nowNs();
+            void *result = List_search(pModel->pList, valueEquals, &value);
+            *pNs += nowNs() - start;
+            if (pModel->size > 0) {
+                int i = pModel->current == BEFORE_START ? 0 : pModel->current;
+                while (i < pModel->size && pModel->items[i]->value != value)
+                    i++;
+                pModel->current = i;
+            }
+            CHECK(result == modelCurrentItem(pModel));
+            break;
+        }
+        case OP_SPLIT: {
+            bool expected = canCreate(pState) && freeNodes(pState, pModel->forward) >= copySize(pState, pModel);
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+            start = nowNs();
+            List *pList = List_split_at_current(pModel->pList);
+            *pNs += nowNs() - start;
+            CHECK((pList != NULL) == expected);
+            if (pList == NULL)
+                break;
+            makePrivate(pState, pModel);
+            int first = pModel->current >= pModel->size ? pModel->size : pModel->current + 1;
+            ModelList *pSlot = freeSlot(pState);
+            pSlot->pList = pList;
+            pSlot->size = 0;
+            pSlot->forward = pModel->forward;
+            insertItems(pSlot, 0, &pModel->items[first], pModel->size - first);
+            pSlot->current = pSlot->size > 0 ? 0 : BEFORE_START;
+            makePrivate(pState, pSlot);
+            leaveIfEmpty(pState, pSlot);
+            removeItems(pModel, first, pModel->size - first);
+            if (pModel->size == 0)
+                pModel->current = BEFORE_START;
+            leaveIfEmpty(pState, pModel);
+            checkList(pState, pSlot);
+            break;
+        }
+        case OP_SPLICE: {
+            ModelList *pSrc = randomList(pState);
+            if (pSrc == pModel || pSrc->size == 0)
+                return NUM_OPS;
+            bool expected = pSrc->forward == pModel->forward &&
+                            freeNodes(pState, pModel->forward) >= copySize(pState, pModel) + copySize(pState, pSrc);
+            if (!expected && !pState->exerciseFailures)
+                return NUM_OPS;
+
+            // Taking cursors for a random range of pSrc
+            int from = randomInt(pState, pSrc->size);
+            int to = from + randomInt(pState, pSrc->size - from);
+            pSrc->current = from;
+            seekCurrent(pState, pSrc);
+            LIST_CURSOR fromCursor = List_cursor(pSrc->pList);
+            pSrc->current = to;
+            seekCurrent(pState, pSrc);
+            LIST_CURSOR toCursor = List_cursor(pSrc->pList);
+
+            bool counted = randomInt(pState, 2) == 0;
+            start = nowNs();
+            int result;
+            if (counted) {
+                result = List_splice_n(pModel->pList, pSrc->pList, fromCursor, toCursor, to - from + 1);
+            } else {
+                result = List_splice(pModel->pList, pSrc->pList, fromCursor, toCursor);
+            }
+            *pNs += nowNs() - start;
+            CHECK(result == (expected ? 0 : -1));
+            if (expected) {
+                makePrivate(pState, pSrc);
+                makePrivate(pState, pModel);
+                int index;
+                if (pModel->size == 0 || pModel->current == pModel->size)
+                    index = pModel->size;
+                else if (pModel->current == BEFORE_START)
+                    index = 0;
+                else
+                    index = pModel->current + 1;
+                insertItems(pModel, index, &pSrc->items[from], to - from + 1);
+                pModel->current = index + to - from;
+                removeItems(pSrc, from, to - from + 1);
+                pSrc->current = pSrc->size == 0 ? BEFORE_START : from;
+                leaveIfEmpty(pState, pSrc);
+            }
+            checkList(pState, pSrc);
+            break;
+        }
+        default:
+            break;
+    }
+    checkList(pState, pModel);
+    return op;
+}
+
+static void *runThread(void *arg) {
+    ThreadState *pState = arg;
+    for (pState->step = 0; pState->step < numOperations; ++pState->step) {
+        double ns = 0;
+        lockLibrary();
+        Operation op = runOperation(pState, &ns);
+        if (op != NUM_OPS) {
+            pState->stats[op].count++;
+            pState->stats[op].ns += ns;
+        }
+        if (pState->step % STRESS_VALIDATE_EVERY == 0) {
+            ModelList *pModel = randomList(pState);
+            if (pModel != NULL)
+                validateList(pState, pModel);
+            if (pState->exerciseFailures)
+                checkPool(pState);
+        }
+        unlockLibrary();
+    }
+
+    // Freeing every list, so that the pool can be checked to be empty afterwards
+    for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+        if (pState->lists[i].pList != NULL) {
+            double ns = 0;
+            lockLibrary();
+            checkFree(pState, &pState->lists[i], &ns);
+            unlockLibrary();
+        }
+    }
+    return NULL;
+}
+
+// Dumps the trace to dumpPath over and over until the operation threads are done, so that List_trace_dump() runs while they are calling
+// List_* functions.  *arg counts the dumps.
+static void *runDumper(void *arg) {
+    long *pDumps = arg;
+    while (atomic_load(&running)) {
+        if (List_trace_dump(dumpPath) != 0) {
+            printf("ERROR: List_trace_dump(\"%s\") failed (list.c must be built with -DLIST_TRACE)\n", dumpPath);
+            exit(1);
+        }
+        (*pDumps)++;
+    }
+    return NULL;
+}
+
+// Measures the cost of the two clock reads around each timed call, so it can be taken out of the reported times
+static void calibrateTimer() {
+    const int samples = 100000;
+    double start = nowNs();
+    for (int i = 0; i < samples; ++i) {
+        double ns = nowNs();
+        ns = nowNs() - ns;
+        (void) ns;
+    }
+    timerOverheadNs = (nowNs() - start) / samples / 2;
+}
+
+int main(int argc, char **argv) {
+    int numThreads = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:t:d:")) != -1) {
+        switch (opt) {
+            case 'n': numOperations = atol(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            case 't': numThreads = atoi(optarg); break;
+            case 'd': dumpPath = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-n operations] [-s seed] [-t threads] [-d trace file]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (numThreads < 1 || numThreads > STRESS_MAX_THREADS || numThreads > LIST_MAX_NUM_HEADS) {
+        fprintf(stderr, "Number of threads must be between 1 and %d\n", LIST_MAX_NUM_HEADS < STRESS_MAX_THREADS ? LIST_MAX_NUM_HEADS : STRESS_MAX_THREADS);
+        return 2;
+    }
+    calibrateTimer();
+
+    printf("seed %llu, %ld operations per thread, %d thread(s), %d nodes, %d forward nodes, %d heads\n", (unsigned long long) seed,
+           numOperations, numThreads, LIST_MAX_NUM_NODES, LIST_MAX_NUM_FORWARD_NODES, LIST_MAX_NUM_HEADS);
+
+    static ThreadState states[STRESS_MAX_THREADS];
+    pthread_t threads[STRESS_MAX_THREADS];
+    for (int t = 0; t < numThreads; ++t) {
+        ThreadState *pState = &states[t];
+        pState->thread = t;
+        pState->rng = (seed + 1) * 0x9E3779B97F4A7C15ULL + t;
+        pState->maxHeads = LIST_MAX_NUM_HEADS / numThreads;
+        pState->maxNodes = LIST_MAX_NUM_NODES / numThreads;
+        pState->maxForwardNodes = LIST_MAX_NUM_FORWARD_NODES / numThreads;
+        pState->exerciseFailures = numThreads == 1;
+        pState->lists = calloc(LIST_MAX_NUM_HEADS, sizeof(ModelList));
+        CHECK(pState->lists != NULL);
+        pState->items = calloc(numOperations + 1, sizeof(StressItem));
+        CHECK(pState->items != NULL);
+        for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+            int maxItems = LIST_MAX_NUM_NODES > LIST_MAX_NUM_FORWARD_NODES ? LIST_MAX_NUM_NODES : LIST_MAX_NUM_FORWARD_NODES;
+            pState->lists[i].items = malloc(maxItems * sizeof(StressItem *));
+            CHECK(pState->lists[i].items != NULL);
+        }
+    }
+    atomic_store(&running, true);
+    pthread_t dumper;
+    long dumps = 0;
+    if (dumpPath != NULL && pthread_create(&dumper, NULL, runDumper, &dumps) != 0) {
+        printf("ERROR: could not start the trace dump thread\n");
+        return 1;
+    }
+    for (int t = 0; t < numThreads; ++t) {
+        ThreadState *pState = &states[t];
+        CHECK(pthread_create(&threads[t], NULL, runThread, pState) == 0);
+    }
+    for (int t = 0; t < numThreads; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    atomic_store(&running, false);
+    if (dumpPath != NULL) {
+        pthread_join(dumper, NULL);
+        printf("%ld trace dumps to %s during the run\n", dumps, dumpPath);
+    }
+    ThreadState *pState = &states[0];
+    CHECK(getNumNodes() == 0);
+    CHECK(getNumForwardNodes() == 0);
+    CHECK(getNumHeads() == 0);
+
+    printf("%-22s %12s %10s %10s\n", "operation", "calls", "ns/call", "Mops/s");
+    for (int op = 0; op < NUM_OPS; ++op) {
+        OpStats total = {0, 0};
+        for (int t = 0; t < numThreads; ++t) {
+            total.count += states[t].stats[op].count;
+            total.ns += states[t].stats[op].ns;
+        }
+        double ns = total.count > 0 ? total.ns / total.count - timerOverheadNs : 0;
+        printf("%-22s %12ld %10.1f %10.2f\n", opNames[op], total.count, ns > 0 ? ns : 0, ns > 0 ? 1e3 / ns : 0);
+    }
+
+    for (int t = 0; t < numThreads; ++t) {
+        for (int i = 0; i < LIST_MAX_NUM_HEADS; ++i) {
+            free(states[t].lists[i].items);
+        }
+        free(states[t].lists);
+        free(states[t].items);
+    }
+    printf("********************************\n");
+    printf("           PASSED\n");
+    printf("********************************\n");
+    return 0;
+}
@@ -30,6 +30,478 @@ static bool itemEquals(void* pItem, void* pArg)
 }
 
 
+static void noFreeFn(void* pItem)
+{
+    CHECK(pItem != NULL);
+}
+
+// For checking that each item is freed exactly once: the item is an int that counts the calls
+static void countingFreeFn(void* pItem)
+{
+    CHECK(pItem != NULL);
+    (*(int*)pItem)++;
+}
+
+// Checks that the items of pList, from first to last, are the ones in items[], and that walking back gives the reverse order
+static void checkItems(List* pList, int* items[], int count)
+{
+    CHECK(List_count(pList) == count);
+    CHECK(List_first(pList) == (count > 0 ? items[0] : NULL));
+    for (int i = 1; i < count; ++i) {
+        CHECK(List_next(pList) == items[i]);
+    }
+    if (count > 0) {
+        CHECK(List_next(pList) == NULL);
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        CHECK(List_prev(pList) == items[i]);
+    }
+}
+
+// Testing the edges of the current pointer: empty lists, and current items before the start or beyond the end of a list
+static void testCurrentEdges() {
+    int values[3] = {0, 1, 2};
+
+    // Testing that List_next() and List_prev() on an empty list return NULL and leave it usable
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    CHECK(List_next(pList) == NULL);
+    CHECK(List_prev(pList) == NULL);
+    CHECK(List_curr(pList) == NULL);
+    CHECK(List_append(pList, &values[0]) == 0);
+    CHECK(List_curr(pList) == &values[0]);
+    CHECK(List_append(pList, &values[1]) == 0);
+    CHECK(List_append(pList, &values[2]) == 0);
+
+    // Testing that List_search() with the current item before the start of the list searches from the first item
+    List_first(pList);
+    CHECK(List_prev(pList) == NULL);
+    CHECK(List_search(pList, itemEquals, &values[0]) == &values[0]);
+    CHECK(List_curr(pList) == &values[0]);
+
+    // Testing that List_trim() with the current item beyond the end, or before the start, makes the new last item the current one
+    List_last(pList);
+    CHECK(List_next(pList) == NULL);
+    CHECK(List_trim(pList) == &values[2]);
+    CHECK(List_curr(pList) == &values[1]);
+    CHECK(List_next(pList) == NULL);
+    CHECK(List_prev(pList) == &values[1]);
+    List_first(pList);
+    CHECK(List_prev(pList) == NULL);
+    CHECK(List_trim(pList) == &values[1]);
+    CHECK(List_curr(pList) == &values[0]);
+    CHECK(List_prev(pList) == NULL);
+    CHECK(List_next(pList) == &values[0]);
+
+    // Testing List_concat() into an empty list: the items are moved and the current item is before the start
+    List *pEmpty = List_create();
+    CHECK(pEmpty != NULL);
+    CHECK(List_concat_checked(pEmpty, pList) == 0);
+    CHECK(List_count(pEmpty) == 1);
+    CHECK(List_curr(pEmpty) == NULL);
+    CHECK(List_next(pEmpty) == &values[0]);
+    CHECK(List_append(pEmpty, &values[1]) == 0);
+    checkItems(pEmpty, (int*[]){&values[0], &values[1]}, 2);
+
+    // Testing List_concat() of two empty lists
+    List *pEmpty2 = List_create();
+    List *pEmpty3 = List_create();
+    CHECK(pEmpty2 != NULL && pEmpty3 != NULL);
+    List_concat(pEmpty2, pEmpty3);
+    CHECK(List_count(pEmpty2) == 0);
+    CHECK(List_next(pEmpty2) == NULL);
+    CHECK(List_append(pEmpty2, &values[2]) == 0);
+    CHECK(List_first(pEmpty2) == &values[2]);
+
+    List_free(pEmpty, noFreeFn);
+    List_free(pEmpty2, noFreeFn);
+    CHECK(getNumNodes() == 0);
+    CHECK(getNumHeads() == 0);
+}
+
+static void testRangeOperations() {
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(List_append(pList, &values[i]) == 0);
+    }
+
+    // Testing List_split_at_current() from the middle of the list.  The split off items form a new list and the current item of pList stays put.
+    List_first(pList);
+    List_next(pList);
+    List *pTail = List_split_at_current(pList);
+    CHECK(pTail != NULL);
+    CHECK(List_curr(pList) == &values[1]);
+    CHECK(List_curr(pTail) == &values[2]);
+    checkItems(pList, (int*[]){&values[0], &values[1]}, 2);
+    checkItems(pTail, (int*[]){&values[2], &values[3], &values[4], &values[5]}, 4);
+
+    // Testing List_splice() by moving the items 3 and 4 from pTail to between 0 and 1 in pList
+    List_first(pTail);
+    List_next(pTail);
+    LIST_CURSOR from = List_cursor(pTail);
+    List_next(pTail);
+    LIST_CURSOR to = List_cursor(pTail);
+    List_first(pList);
+    List_splice(pList, pTail, from, to);
+    CHECK(List_curr(pList) == &values[4]);
+    CHECK(List_curr(pTail) == &values[5]);
+    checkItems(pList, (int*[]){&values[0], &values[3], &values[4], &values[1]}, 4);
+    checkItems(pTail, (int*[]){&values[2], &values[5]}, 2);
+
+    // Testing List_splice_n() by moving the whole of pTail to the start of pList, which leaves pTail empty
+    List_first(pTail);
+    from = List_cursor(pTail);
+    List_last(pTail);
+    to = List_cursor(pTail);
+    List_first(pList);
+    List_prev(pList);
+    List_splice_n(pList, pTail, from, to, 2);
+    checkItems(pList, (int*[]){&values[2], &values[5], &values[0], &values[3], &values[4], &values[1]}, 6);
+    CHECK(List_count(pTail) == 0);
+    CHECK(List_cursor(pTail) == NULL);
+
+    // Testing List_split_at_current() with the current item before the start of the list, which moves every item
+    List_first(pList);
+    List_prev(pList);
+    List *pAll = List_split_at_current(pList);
+    CHECK(List_count(pList) == 0);
+    CHECK(List_count(pAll) == 6);
+    CHECK(List_append(pList, &values[0]) == 0);
+    CHECK(List_last(pAll) == &values[1]);
+
+    // Testing that freeing the lists frees every item once, except values[0], which was appended to pList again and so is held by two lists
+    List_free(pList, countingFreeFn);
+    List_free(pTail, countingFreeFn);
+    List_free(pAll, countingFreeFn);
+    CHECK(values[0] == 2);
+    for (int i = 1; i < 6; ++i) {
+        CHECK(values[i] == i + 1);
+    }
+}
+
+// Testing that items moved between lists that were never cloned are freed with the list holding them
+static void testMovedItemsFreed() {
+    int values[6] = {0};
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(List_append(pList, &values[i]) == 0);
+    }
+    List_first(pList);
+    List *pTail = List_split_at_current(pList);
+    CHECK(pTail != NULL);
+    List_free(pTail, countingFreeFn);
+    CHECK(values[0] == 0 && values[1] == 1 && values[2] == 1 && values[3] == 1);
+    List_free(pList, countingFreeFn);
+    CHECK(values[0] == 1);
+
+    // Splicing one item between two lists of three
+    memset(values, 0, sizeof(values));
+    List *pDst = List_create();
+    List *pSrc = List_create();
+    CHECK(pDst != NULL && pSrc != NULL);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(List_append(pDst, &values[i]) == 0);
+        CHECK(List_append(pSrc, &values[3 + i]) == 0);
+    }
+    List_first(pSrc);
+    LIST_CURSOR cursor = List_cursor(pSrc);
+    CHECK(List_splice(pDst, pSrc, cursor, cursor) == 0);
+    List_free(pSrc, countingFreeFn);
+    List_free(pDst, countingFreeFn);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(values[i] == 1);
+    }
+    CHECK(getNumNodes() == 0);
+}
+
+static void testCloneCow() {
+    int values[4] = {0, 1, 2, 3};
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(List_append(pList, &values[i]) == 0);
+    }
+
+    // Testing that List_clone_cow() gives a list with the same items and current item, without using any nodes
+    List_first(pList);
+    List *pClone = List_clone_cow(pList);
+    CHECK(pClone != NULL);
+    CHECK(List_curr(pClone) == &values[0]);
+    checkItems(pClone, (int*[]){&values[0], &values[1], &values[2]}, 3);
+
+    // Testing that modifying either list does not change the other
+    CHECK(List_append(pList, &values[3]) == 0);
+    List_first(pClone);
+    CHECK(List_remove(pClone) == &values[0]);
+    checkItems(pList, (int*[]){&values[0], &values[1], &values[2], &values[3]}, 4);
+    checkItems(pClone, (int*[]){&values[1], &values[2]}, 2);
+
+    // Testing that freeing a list whose nodes are still shared does not free its items
+    List *pSnapshot = List_clone_cow(pList);
+    CHECK(pSnapshot != NULL);
+    List_free(pList, countingFreeFn);
+    CHECK(values[0] == 0 && values[1] == 1 && values[2] == 2 && values[3] == 3);
+
+    // Testing that freeing a list only frees the items no other list of its clone family holds: 0 and 3 are no longer in pClone
+    checkItems(pSnapshot, (int*[]){&values[0], &values[1], &values[2], &values[3]}, 4);
+    List_free(pSnapshot, countingFreeFn);
+    CHECK(values[0] == 1 && values[1] == 1 && values[2] == 2 && values[3] == 4);
+
+    // Testing List_splice() with cursors taken from a list that shares its nodes
+    List *pShared = List_clone_cow(pClone);
+    CHECK(pShared != NULL);
+    List *pDst = List_create();
+    CHECK(pDst != NULL);
+    List_first(pShared);
+    LIST_CURSOR from = List_cursor(pShared);
+    List_splice(pDst, pShared, from, from);
+    checkItems(pDst, (int*[]){&values[1]}, 1);
+    checkItems(pShared, (int*[]){&values[2]}, 1);
+    checkItems(pClone, (int*[]){&values[1], &values[2]}, 2);
+
+    // Testing that the list the items were spliced into joined the clone family, so that each item is freed by the last list holding it
+    List_free(pClone, countingFreeFn);
+    CHECK(values[1] == 1 && values[2] == 2);
+    List_free(pShared, countingFreeFn);
+    CHECK(values[2] == 3);
+    List_free(pDst, countingFreeFn);
+    CHECK(values[1] == 2);
+
+    // Testing the clone, mutate the original, free the clone case: the clone frees nothing the original still holds, and the original then
+    // frees every item, including the one added after the copy
+    memset(values, 0, sizeof(values));
+    List *pOriginal = List_create();
+    CHECK(pOriginal != NULL);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(List_append(pOriginal, &values[i]) == 0);
+    }
+    pSnapshot = List_clone_cow(pOriginal);
+    CHECK(pSnapshot != NULL);
+    CHECK(List_append(pOriginal, &values[3]) == 0);
+    List_free(pSnapshot, countingFreeFn);
+    CHECK(values[0] == 0 && values[1] == 0 && values[2] == 0);
+    List_free(pOriginal, countingFreeFn);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(values[i] == 1);
+    }
+
+    // Testing the reverse: the clone adds an item and is freed last
+    memset(values, 0, sizeof(values));
+    pOriginal = List_create();
+    CHECK(pOriginal != NULL);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(List_append(pOriginal, &values[i]) == 0);
+    }
+    pSnapshot = List_clone_cow(pOriginal);
+    CHECK(pSnapshot != NULL);
+    CHECK(List_append(pSnapshot, &values[3]) == 0);
+    List_first(pOriginal);
+    CHECK(List_remove(pOriginal) == &values[0]);
+    List_free(pOriginal, countingFreeFn);
+    CHECK(values[0] == 0 && values[1] == 0 && values[2] == 0);
+    List_free(pSnapshot, countingFreeFn);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(values[i] == 1);
+    }
+    CHECK(getNumNodes() == 0);
+}
+
+// Testing the nodes used by modifying a list that shares its nodes while the pool is nearly full
+static void testCloneCowFullPool() {
+    int value = 0;
+    int half = LIST_MAX_NUM_NODES / 2;
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < half; ++i) {
+        CHECK(List_append(pList, &value) == 0);
+    }
+    List *pClone = List_clone_cow(pList);
+    CHECK(pClone != NULL);
+    List *pClone2 = List_clone_cow(pList);
+    CHECK(pClone2 != NULL);
+
+    // Filling the pool so that exactly as many nodes as the list holds are left
+    List *pFill = List_create();
+    CHECK(pFill != NULL);
+    while (getNumNodes() < LIST_MAX_NUM_NODES - half) {
+        CHECK(List_append(pFill, &value) == 0);
+    }
+
+    // Testing that adding to the shared list fails without taking the copy, since the copy fits but the new node does not
+    CHECK(List_append(pList, &value) == -1);
+    CHECK(List_add(pList, &value) == -1);
+    CHECK(List_insert(pList, &value) == -1);
+    CHECK(List_prepend(pList, &value) == -1);
+    CHECK(getNumNodes() == LIST_MAX_NUM_NODES - half);
+
+    // Leaving one node fewer than the list holds, and testing that List_concat() and List_splice() fail as well
+    CHECK(List_append(pFill, &value) == 0);
+    List *pOther = List_create();
+    CHECK(pOther != NULL);
+    CHECK(List_concat_checked(pOther, pList) == -1);
+    List_concat(pOther, pList);
+    List_first(pList);
+    LIST_CURSOR cursor = List_cursor(pList);
+    CHECK(List_splice(pOther, pList, cursor, cursor) == -1);
+    CHECK(List_count(pList) == half);
+    CHECK(List_count(pOther) == 0);
+
+    // Testing that removing from the shared list only needs as many nodes as the list holds afterwards
+    List_first(pList);
+    CHECK(List_remove(pList) == &value);
+    CHECK(List_count(pList) == half - 1);
+    CHECK(getNumNodes() == LIST_MAX_NUM_NODES);
+
+    // Testing that a removal that cannot be copied (pClone still shares its nodes with pClone2) leaves the list unchanged and can be told
+    // apart from an out of bounds current item
+    List_last(pClone);
+    CHECK(List_remove(pClone) == NULL);
+    CHECK(List_curr(pClone) == &value);
+    CHECK(List_trim(pClone) == NULL);
+    CHECK(List_count(pClone) == half);
+
+    List_free(pFill, noFreeFn);
+    List_free(pOther, noFreeFn);
+    List_free(pList, noFreeFn);
+    List_free(pClone, noFreeFn);
+    List_free(pClone2, noFreeFn);
+    CHECK(getNumNodes() == 0);
+}
+
+static void testForwardList() {
+    int values[5] = {0, 1, 2, 3, 4};
+    List *pList = List_create_forward();
+    CHECK(pList != NULL);
+
+    // Testing that a forward-only list takes its nodes from the forward node pool
+    CHECK(List_append(pList, &values[1]) == 0);
+    CHECK(List_append(pList, &values[3]) == 0);
+    CHECK(List_prepend(pList, &values[0]) == 0);
+    CHECK(getNumForwardNodes() == 3);
+    CHECK(getNumNodes() == 0);
+
+    // Testing the emulated backward operations: List_insert() and List_prev() find the previous node by walking the list
+    List_last(pList);
+    CHECK(List_insert(pList, &values[2]) == 0);
+    CHECK(List_prev(pList) == &values[1]);
+    CHECK(List_add(pList, &values[4]) == 0);
+    checkItems(pList, (int*[]){&values[0], &values[1], &values[4], &values[2], &values[3]}, 5);
+
+    // Testing List_remove() in the middle and at the end of the list, and List_trim()
+    List_first(pList);
+    List_next(pList);
+    List_next(pList);
+    CHECK(List_remove(pList) == &values[4]);
+    CHECK(List_curr(pList) == &values[2]);
+    List_last(pList);
+    CHECK(List_remove(pList) == &values[3]);
+    CHECK(List_curr(pList) == NULL);
+    CHECK(List_trim(pList) == &values[2]);
+    CHECK(List_curr(pList) == &values[1]);
+    checkItems(pList, (int*[]){&values[0], &values[1]}, 2);
+
+    // Testing List_search(), List_concat() and List_free() between forward-only lists
+    List *pList2 = List_create_forward();
+    CHECK(pList2 != NULL);
+    CHECK(List_append(pList2, &values[2]) == 0);
+    List_concat(pList, pList2);
+    List_first(pList);
+    CHECK(List_search(pList, itemEquals, &values[2]) == &values[2]);
+
+    // Testing that a forward-only list and a doubly linked list are not joined
+    List *pDoubly = List_create();
+    CHECK(pDoubly != NULL);
+    CHECK(List_append(pDoubly, &values[3]) == 0);
+    CHECK(List_concat_checked(pList, pDoubly) == -1);
+    CHECK(List_concat_checked(pDoubly, pList) == -1);
+    List_first(pList);
+    LIST_CURSOR cursor = List_cursor(pList);
+    CHECK(List_splice(pDoubly, pList, cursor, cursor) == -1);
+    CHECK(List_splice_n(pDoubly, pList, cursor, cursor, 1) == -1);
+    checkItems(pList, (int*[]){&values[0], &values[1], &values[2]}, 3);
+    checkItems(pDoubly, (int*[]){&values[3]}, 1);
+    List_free(pDoubly, noFreeFn);
+    complexTestFreeCounter = 0;
+    List_free(pList, complexTestFreeFn);
+    CHECK(complexTestFreeCounter == 3);
+    complexTestFreeCounter = 0;
+    CHECK(getNumForwardNodes() == 0);
+}
+
+#ifdef LIST_TRACE
+// Testing that calls are recorded and dumped by List_trace_dump() when list.c is built with tracing.  Only the client's calls are
+// recorded: List_remove() at the end of a list calls List_next() internally, which must not appear in the trace.
+static void testTrace() {
+    int value = 0;
+    List *pList = List_create();
+    CHECK(pList != NULL);
+    CHECK(List_append(pList, &value) == 0);
+    CHECK(List_append(pList, &value) == 0);
+    List_last(pList);
+    CHECK(List_remove(pList) == &value);
+    List_free(pList, noFreeFn);
+
+    const char *path = "test_trace.txt";
+    CHECK(List_trace_dump(path) == 0);
+    FILE *file = fopen(path, "r");
+    CHECK(file != NULL);
+    const char *expected[5] = {"List_append", "List_append", "List_last", "List_remove", "List_free"};
+    int expectedSizes[5] = {1, 2, 2, 1, 0};
+    char ops[5][32] = {"", "", "", "", ""};
+    int sizes[5] = {0, 0, 0, 0, 0};
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        // Keeping the last five records, which should be the calls above
+        char op[32];
+        int thread, list, size;
+        if (line[0] != '#' && sscanf(line, "%d %31s %d %d", &thread, op, &list, &size) == 4) {
+            memmove(ops[0], ops[1], sizeof(ops[0]) * 4);
+            memmove(&sizes[0], &sizes[1], sizeof(sizes[0]) * 4);
+            strcpy(ops[4], op);
+            sizes[4] = size;
+        }
+    }
+    fclose(file);
+    remove(path);
+    for (int i = 0; i < 5; ++i) {
+        CHECK(strcmp(ops[i], expected[i]) == 0);
+        CHECK(sizes[i] == expectedSizes[i]);
+    }
+
+    // Testing that the List_count() of a full pool is recorded in full (make test-trace uses a pool of more than 255 nodes, which does not fit
+    // in a byte), under the thread number of the only thread, 0
+    pList = List_create();
+    CHECK(pList != NULL);
+    for (int i = 0; i < LIST_MAX_NUM_NODES; ++i) {
+        CHECK(List_append(pList, &value) == 0);
+    }
+    CHECK(List_count(pList) == LIST_MAX_NUM_NODES);
+    List_free(pList, noFreeFn);
+    CHECK(List_trace_dump(path) == 0);
+    file = fopen(path, "r");
+    CHECK(file != NULL);
+    int countThread = -1, countResult = -1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char op[32];
+        int thread, list, size, result;
+        unsigned long long start;
+        unsigned int duration;
+        if (line[0] != '#' && sscanf(line, "%d %31s %d %d %llu %u %d", &thread, op, &list, &size, &start, &duration, &result) == 7
+            && strcmp(op, "List_count") == 0) {
+            countThread = thread;
+            countResult = result;
+        }
+    }
+    fclose(file);
+    remove(path);
+    CHECK(countThread == 0);
+    CHECK(countResult == LIST_MAX_NUM_NODES);
+}
+#endif
+
 static void testComplex() {
     // Testing the functionality of List_create()
     List *pListArr[LIST_MAX_NUM_HEADS + 1];
@@ -188,6 +660,15 @@ static void testComplex() {
 
 int main() {
 
+    testCurrentEdges();
+    testRangeOperations();
+    testMovedItemsFreed();
+    testCloneCow();
+    testCloneCowFullPool();
+    testForwardList();
+#ifdef LIST_TRACE
+    testTrace();
+#endif
     testComplex();
 
     printf("********************************\n");
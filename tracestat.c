@@ -0,0 +1,171 @@
+//
+// Offline analysis of a trace written by List_trace_dump() (list.c compiled with -DLIST_TRACE).
+//
+// Usage: ./tracestat [-b buckets] trace.txt
+//
+// Prints, for each List_* function, the number of calls and the 50th, 90th, 99th and 99.9th percentile and maximum
+// latencies, followed by a timeline splitting the traced period into buckets (default 20) with the number of calls, the
+// slowest call and the list it was made on in each bucket.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Longest List_* function name in a trace
+#define TRACESTAT_MAX_NAME 32
+
+// Maximum number of distinct operations in a trace
+#define TRACESTAT_MAX_OPS 64
+
+typedef struct {
+    int thread;
+    int op;
+    int list;
+    int size;
+    unsigned long long start;
+    unsigned int duration;
+    int result;
+} Record;
+
+static char opNames[TRACESTAT_MAX_OPS][TRACESTAT_MAX_NAME];
+static int numOps = 0;
+
+// Returns the index of the named operation, adding it if it has not been seen yet
+static int opIndex(const char *name) {
+    for (int i = 0; i < numOps; ++i) {
+        if (strcmp(opNames[i], name) == 0)
+            return i;
+    }
+    if (numOps == TRACESTAT_MAX_OPS) {
+        fprintf(stderr, "Too many distinct operations in trace\n");
+        exit(1);
+    }
+    snprintf(opNames[numOps], TRACESTAT_MAX_NAME, "%s", name);
+    return numOps++;
+}
+
+static int compareDurations(const void *a, const void *b) {
+    unsigned int x = *(const unsigned int *) a;
+    unsigned int y = *(const unsigned int *) b;
+    return (x > y) - (x < y);
+}
+
+// Returns the duration at the given percentile of the sorted durations
+static unsigned int percentile(const unsigned int *sorted, long count, double percent) {
+    long index = (long) (percent / 100.0 * count);
+    return sorted[index < count ? index : count - 1];
+}
+
+int main(int argc, char **argv) {
+    int numBuckets = 20;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:")) != -1) {
+        switch (opt) {
+            case 'b': numBuckets = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-b buckets] trace.txt\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind != argc - 1 || numBuckets < 1) {
+        fprintf(stderr, "Usage: %s [-b buckets] trace.txt\n", argv[0]);
+        return 2;
+    }
+    FILE *file = fopen(argv[optind], "r");
+    if (file == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    // Reading the header for the tick rate, then every record
+    double ticksPerNs = 0;
+    if (fscanf(file, "# list-trace 1 ticks_per_ns %lf\n", &ticksPerNs) != 1 || ticksPerNs <= 0) {
+        fprintf(stderr, "%s is not a list trace\n", argv[optind]);
+        return 1;
+    }
+    long numRecords = 0;
+    long capacity = 1024;
+    Record *records = malloc(capacity * sizeof(Record));
+    char line[256];
+    char name[TRACESTAT_MAX_NAME];
+    while (records != NULL && fgets(line, sizeof(line), file) != NULL) {
+        Record record;
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, "%d %31s %d %d %llu %u %d", &record.thread, name, &record.list, &record.size, &record.start,
+                   &record.duration, &record.result) != 7) {
+            fprintf(stderr, "Malformed record: %s", line);
+            return 1;
+        }
+        record.op = opIndex(name);
+        if (numRecords == capacity) {
+            capacity *= 2;
+            records = realloc(records, capacity * sizeof(Record));
+            if (records == NULL)
+                break;
+        }
+        records[numRecords++] = record;
+    }
+    fclose(file);
+    if (records == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (numRecords == 0) {
+        printf("No records\n");
+        return 0;
+    }
+
+    // Latency percentiles per operation
+    unsigned int *durations = malloc(numRecords * sizeof(unsigned int));
+    if (durations == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    printf("%-22s %10s %10s %10s %10s %10s %10s\n", "operation", "calls", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+    for (int op = 0; op < numOps; ++op) {
+        long count = 0;
+        for (long i = 0; i < numRecords; ++i) {
+            if (records[i].op == op)
+                durations[count++] = records[i].duration;
+        }
+        qsort(durations, count, sizeof(unsigned int), compareDurations);
+        printf("%-22s %10ld %10.1f %10.1f %10.1f %10.1f %10.1f\n", opNames[op], count,
+               percentile(durations, count, 50) / ticksPerNs, percentile(durations, count, 90) / ticksPerNs,
+               percentile(durations, count, 99) / ticksPerNs, percentile(durations, count, 99.9) / ticksPerNs,
+               durations[count - 1] / ticksPerNs);
+    }
+    free(durations);
+
+    // Timeline: the traced period split into equal buckets by start time
+    unsigned long long first = records[0].start;
+    unsigned long long last = records[0].start + records[0].duration;
+    for (long i = 1; i < numRecords; ++i) {
+        if (records[i].start < first)
+            first = records[i].start;
+        if (records[i].start + records[i].duration > last)
+            last = records[i].start + records[i].duration;
+    }
+    unsigned long long width = (last - first) / numBuckets + 1;
+    printf("\n%12s %10s %12s  %s\n", "offset us", "calls", "slowest ns", "slowest call");
+    for (int bucket = 0; bucket < numBuckets; ++bucket) {
+        long calls = 0;
+        const Record *slowest = NULL;
+        for (long i = 0; i < numRecords; ++i) {
+            if ((records[i].start - first) / width != (unsigned long long) bucket)
+                continue;
+            calls++;
+            if (slowest == NULL || records[i].duration > slowest->duration)
+                slowest = &records[i];
+        }
+        printf("%12.1f %10ld", bucket * width / ticksPerNs / 1000, calls);
+        if (slowest != NULL)
+            printf(" %12.1f  %s (thread %d, list %d, size %d)", slowest->duration / ticksPerNs, opNames[slowest->op],
+                   slowest->thread, slowest->list, slowest->size);
+        printf("\n");
+    }
+    free(records);
+    return 0;
+}